@@ -0,0 +1,49 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+
+#include "level.h"
+
+#ifndef SOKOBAN_BATCH_H
+#define SOKOBAN_BATCH_H
+
+// N copies of one level stepped together, without SDL.
+// Boards are stored as flat arrays (structure of arrays). Every board is padded
+// with a wall border and a guard row above and below, so a push never needs
+// bounds checks: cell (x, y) has index (y + 2) * stride + x + 1.
+// Boards that fit a width class of kernels.h use class width as stride.
+typedef struct batchEnv {
+    int num, maxSteps, chestNum;
+    int rows, cols, stride, cells;
+    int offset[4];              // cell offset for each Dir
+
+    uint8_t *wall, *dest;       // [cells], shared by every board
+    uint8_t *startChests;       // [cells], level start position
+    int32_t startPlayer, startAtDest;
+
+    int32_t *player;            // [num] player cell
+    uint8_t *chests;            // [num * cells] 1 where chest stands
+    int32_t *atDest;            // [num] chests on destination
+    int32_t *steps;             // [num] steps in current episode
+
+    int32_t *target;            // [num] scratch of stepBatchEnv()
+    uint8_t *canMove, *push;    // [num] scratch of stepBatchEnv()
+
+    // legality pass of stepBatchEnv() specialised for stride, chosen by initBatchEnv()
+    void (*checkMoves)(struct batchEnv *env, const uint8_t *actions);
+} batchEnv_t;
+
+int initBatchEnv(batchEnv_t *env, const level_t *level, int num, int maxSteps);
+
+void freeBatchEnv(batchEnv_t *env);
+
+void resetBatchEnv(batchEnv_t *env);
+
+// moves every board by its action (Dir). For board i fills rewards[i], dones[i]
+// and atDest[i] (chests on destination after the move). Finished boards
+// (solved or out of steps) are reset in place before returning.
+void stepBatchEnv(batchEnv_t *env, const uint8_t *actions,
+                  float *rewards, uint8_t *dones, int32_t *atDest);
+
+#endif //SOKOBAN_BATCH_H
@@ -41,4 +41,13 @@ const float ANIMATED_FPS = 20.0f;
 
 const int DELAY = 300;
 
+// win screen drops in for WIN_SCREEN_DROP ms and stays until WIN_SCREEN_TIME ms or a key press
+const int WIN_SCREEN_DROP = 400;
+const int WIN_SCREEN_TIME = 1500;
+
+// rewards used by batch environment (see batch.h)
+const float STEP_REWARD = -0.1f;
+const float CHEST_REWARD = 1.0f;
+const float WIN_REWARD = 10.0f;
+
 #endif //SOKOBAN_CONSTS_H
@@ -6,6 +6,7 @@
 #include "graphics.h"
 #include "player.h"
 #include "board.h"
+#include "level.h"
 
 #ifndef SOKOBAN_DRAW_H
 #define SOKOBAN_DRAW_H
@@ -23,4 +24,8 @@ void drawRectangle(SDL_Surface *screen, int x, int y, int l, int k,
                    Uint32 outlineColor, Uint32 fillColor);
 
 void drawBoard(const graphics_t *vfx, const player_t *player, const board_t *board, int t1);
+
+void blendSurface(SDL_Surface *screen, const SDL_Surface *sprite, int x, int y);
+
+void drawThumbnail(SDL_Surface *screen, const thumbSprites_t *sprites, const level_t *level, int x, int y);
 #endif //SOKOBAN_DRAW_H
@@ -0,0 +1,36 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "level.h"
+
+#ifndef SOKOBAN_FINGERPRINT_H
+#define SOKOBAN_FINGERPRINT_H
+
+// identity of a puzzle, the same for every rotation and reflection of it.
+// Floor outside of player area is treated as wall, board is cropped to what
+// is left and player position only matters up to the area he can walk in.
+uint64_t levelFingerprint(const level_t *level);
+
+// fingerprint -> name, kept in memory and appended to file (when path is given)
+typedef struct levelIndex {
+    FILE *file;
+    std::unordered_map<uint64_t, std::string> names;
+} levelIndex_t;
+
+int openLevelIndex(levelIndex_t *index, const char *path);
+
+void closeLevelIndex(levelIndex_t *index);
+
+// returns name level was first seen with, NULL for unknown level
+const char *findLevel(const levelIndex_t *index, uint64_t fingerprint);
+
+// returns 1 when level was not known before and has been added
+int addLevel(levelIndex_t *index, uint64_t fingerprint, const char *name);
+
+#endif //SOKOBAN_FINGERPRINT_H
@@ -6,6 +6,8 @@
 #include "player.h"
 #include "colors.h"
 #include "graphics.h"
+#include "heuristic.h"
+#include "loader.h"
 
 #ifndef SOKOBAN_GAME_H
 #define SOKOBAN_GAME_H
@@ -21,6 +23,12 @@ typedef struct variables {
     double delta, worldTime, fpsTimer, fps;
 
     board_t board;
+    Uint64 levelId;     // levelFingerprint(), the same for rotated or renamed copies
+    heuristic_t heuristic;
+
+    int levelIndex;
+    Uint32 won, winTime, skipWin;
+    levelLoader_t loader;
 
     graphics_t vfx;
     colors_t colors;
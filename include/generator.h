@@ -0,0 +1,34 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+
+#include "level.h"
+#include "solver.h"
+
+#ifndef SOKOBAN_GENERATOR_H
+#define SOKOBAN_GENERATOR_H
+
+typedef struct generatorConfig {
+    int rows, cols;             // room size including outer walls
+    int chestNum;
+    int pulls;                  // reverse play length
+    int minPushes;              // easier levels are rejected
+    long minPositions;          // levels with smaller deadlock free state space are rejected
+    long maxNodes;              // solver budget for one candidate
+} generatorConfig_t;
+
+// seeds independent random stream, one per thread
+uint64_t seedRandom(uint64_t seed, uint64_t stream);
+
+uint64_t nextRandom(uint64_t *rng);
+
+// builds random room, puts chests on destinations and scatters them by
+// pulling them around. Candidate is verified by solver, which gives its
+// difficulty (score->pushes, optimal pushes), then countPositions() gives
+// its complexity (score->positions, deadlock free positions, at most maxNodes).
+// Returns ERROR when candidate was rejected, level is then left empty.
+int generateLevel(const generatorConfig_t *config, uint64_t *rng,
+                  level_t *level, solverResult_t *score);
+
+#endif //SOKOBAN_GENERATOR_H
@@ -30,6 +30,13 @@ typedef struct graphics {
     pSprites_t pSprites;
 } graphics_t;
 
+// read-only sprites scaled to thumbnail tile size, shared by render threads
+typedef struct thumbSprites {
+    field_t field;
+    SDL_Surface *player;
+    int tile;
+} thumbSprites_t;
+
 const int SPRITE_WIDTH = 64;
 const int SPRITE_HEIGHT = 64;
 
@@ -0,0 +1,46 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+
+#include "solver.h"
+
+#ifndef SOKOBAN_HEURISTIC_H
+#define SOKOBAN_HEURISTIC_H
+
+const int HEURISTIC_INF = 1 << 20;
+
+// lower bound of pushes left: every chest is matched with its own destination
+// so that sum of push distances (walls respected, other chests ignored) is
+// minimal. Matching is Hungarian method on a square matrix (missing chests are
+// zero cost rows) and is repaired row by row when a chest is pushed.
+typedef struct heuristic {
+    int size, chestNum, destNum, cells, stride;
+
+    int *distance;          // [destNum * cells] pushes from cell to destination
+    int *chestCell;         // [size] cell of chest, -1 for padding rows
+    int *chestAt;           // [cells] chest standing on cell or -1
+
+    int *u, *v;             // [size + 1] potentials of chests and destinations
+    int *owner;             // [size + 1] chest matched with destination, 1-based
+    int *match;             // [size + 1] destination matched with chest, 1-based
+    int *minv, *way;        // [size + 1] scratch
+    uint8_t *used;          // [size + 1] scratch
+
+    int bound;              // pushes left at least, HEURISTIC_INF for deadlock
+} heuristic_t;
+
+// returns ERROR when there are fewer destinations than chests, bound is then
+// HEURISTIC_INF and moveChest() leaves it alone
+int initHeuristic(heuristic_t *h, const solverMap_t *map);
+
+void freeHeuristic(heuristic_t *h);
+
+// matches chests from scratch
+void setChests(heuristic_t *h, const uint8_t *chests);
+
+// chest was pushed, only its row of matching is solved again.
+// Does nothing for heuristic that was never initialised.
+void moveChest(heuristic_t *h, int from, int to);
+
+#endif //SOKOBAN_HEURISTIC_H
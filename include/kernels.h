@@ -0,0 +1,165 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "solver.h"
+
+#ifndef SOKOBAN_KERNELS_H
+#define SOKOBAN_KERNELS_H
+
+// Hot loops are templates on board stride W (columns plus wall border), so
+// offsets of neighbours are constants and a whole W x W board fits in a few
+// 64 bit words. Boards get the smallest class they fit in when level is
+// loaded; W = 0 is the runtime stride fallback for anything larger.
+const int WIDTH_CLASSES[] = {8, 16};
+
+inline int strideClass(int width) {
+    for(int i = 0; i < 2; i++) {
+        if(width <= WIDTH_CLASSES[i])
+            return WIDTH_CLASSES[i];
+    }
+    return 0;
+}
+
+inline int lowestBit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long bit;
+    _BitScanForward64(&bit, word);
+    return (int)bit;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// W x W cells, one bit each
+template<int W>
+struct bitboard {
+    static const int WORDS = W * W / 64;
+    uint64_t word[WORDS];
+};
+
+// out = in moved S cells towards higher (UP) or lower cell numbers
+template<int N, int S>
+inline void shiftUp(const uint64_t *in, uint64_t *out) {
+    const int words = S / 64, bits = S % 64;
+
+    for(int i = N - 1; i >= 0; i--) {
+        uint64_t value = (i - words >= 0 ? in[i - words] << bits : 0);
+        if(bits && i - words - 1 >= 0)
+            value |= in[i - words - 1] >> ((64 - bits) % 64);
+        out[i] = value;
+    }
+}
+
+template<int N, int S>
+inline void shiftDown(const uint64_t *in, uint64_t *out) {
+    const int words = S / 64, bits = S % 64;
+
+    for(int i = 0; i < N; i++) {
+        uint64_t value = (i + words < N ? in[i + words] >> bits : 0);
+        if(bits && i + words + 1 < N)
+            value |= in[i + words + 1] << ((64 - bits) % 64);
+        out[i] = value;
+    }
+}
+
+// grows reach inside open until it stops changing. Wall border is never
+// open, so bits moved over the edge of a row are always masked out.
+template<int W>
+inline void flood(const bitboard<W> &open, bitboard<W> *reach) {
+    const int N = bitboard<W>::WORDS;
+    uint64_t moved[N], grown[N];
+
+    for(;;) {
+        bool changed = false;
+
+        for(int i = 0; i < N; i++)
+            grown[i] = reach->word[i];
+
+        shiftUp<N, 1>(reach->word, moved);
+        for(int i = 0; i < N; i++) grown[i] |= moved[i];
+        shiftDown<N, 1>(reach->word, moved);
+        for(int i = 0; i < N; i++) grown[i] |= moved[i];
+        shiftUp<N, W>(reach->word, moved);
+        for(int i = 0; i < N; i++) grown[i] |= moved[i];
+        shiftDown<N, W>(reach->word, moved);
+        for(int i = 0; i < N; i++) grown[i] |= moved[i];
+
+        for(int i = 0; i < N; i++) {
+            grown[i] &= open.word[i];
+            changed |= (grown[i] != reach->word[i]);
+            reach->word[i] = grown[i];
+        }
+
+        if(!changed)
+            return;
+    }
+}
+
+// player area of a position. Caller keeps chests array up to date and
+// reports every chest it moves, so bitboard kernels can follow.
+template<int W>
+struct reachKernel {
+    bitboard<W> open, reach;
+
+    void load(const solverMap_t *map, const uint8_t *chests) {
+        memset(open.word, 0, sizeof(open.word));
+        for(int cell = 0; cell < map->cells; cell++) {
+            if(!map->wall[cell] && !chests[cell])
+                open.word[cell / 64] |= 1ULL << (cell % 64);
+        }
+    }
+
+    void move(int from, int to) {
+        open.word[from / 64] |= 1ULL << (from % 64);
+        open.word[to / 64] &= ~(1ULL << (to % 64));
+    }
+
+    // returns the smallest reached cell
+    int fill(int start) {
+        memset(reach.word, 0, sizeof(reach.word));
+        reach.word[start / 64] |= 1ULL << (start % 64);
+
+        flood<W>(open, &reach);
+
+        for(int i = 0; ; i++) {
+            if(reach.word[i])
+                return i * 64 + lowestBit(reach.word[i]);
+        }
+    }
+
+    bool reached(int cell) const {
+        return (reach.word[cell / 64] >> (cell % 64)) & 1;
+    }
+};
+
+// boards wider than every class
+template<>
+struct reachKernel<0> {
+    const solverMap_t *map;
+    const uint8_t *chests;
+    std::vector<uint8_t> reach;
+
+    void load(const solverMap_t *solverMap, const uint8_t *chestCells) {
+        map = solverMap;
+        chests = chestCells;
+        reach.resize(map->cells);
+    }
+
+    void move(int, int) {
+    }
+
+    int fill(int start) {
+        return reachable(map, chests, start, reach.data());
+    }
+
+    bool reached(int cell) const {
+        return reach[cell];
+    }
+};
+
+#endif //SOKOBAN_KERNELS_H
@@ -0,0 +1,35 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdio.h>
+
+#include "board.h"
+
+#ifndef SOKOBAN_LEVEL_H
+#define SOKOBAN_LEVEL_H
+
+typedef struct level {
+    board_t board;
+    int playerX, playerY, chestNum;
+} level_t;
+
+int getFieldType(char c);
+
+char getFieldChar(int type);
+
+int parseLevel(const char *path, level_t *level);
+
+void freeLevel(level_t *level);
+
+// writes level in loadLevel() format
+void writeLevel(FILE *out, const level_t *level);
+
+// writes level in XSB format, the one used by most level collections
+void writeLevelXSB(FILE *out, const level_t *level, const char *title);
+
+// reads next level of XSB collection, title gets the last comment before it,
+// or the "Title:" line after it when there is none before.
+// Returns QUIT at the end of file and ERROR for a malformed level.
+int readLevelXSB(FILE *in, level_t *level, char *title);
+
+#endif //SOKOBAN_LEVEL_H
@@ -0,0 +1,53 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include "level.h"
+#include "heuristic.h"
+#include "consts.h"
+
+#ifndef SOKOBAN_LOADER_H
+#define SOKOBAN_LOADER_H
+
+// level parsed and analysed, ready to be played
+typedef struct preparedLevel {
+    level_t level;
+    heuristic_t heuristic;
+    uint64_t levelId;
+} preparedLevel_t;
+
+enum LoaderState {
+    LOADER_IDLE = 0,
+    LOADER_BUSY,
+    LOADER_READY,
+    LOADER_FAILED
+};
+
+// prepares one level on background thread, no SDL calls are made there
+typedef struct levelLoader {
+    std::thread thread;
+    std::atomic<int> state;
+    char path[MAX_TEXT_LENGTH];
+    preparedLevel_t prepared;
+} levelLoader_t;
+
+int prepareLevel(const char *path, preparedLevel_t *prepared);
+
+void freePreparedLevel(preparedLevel_t *prepared);
+
+void startLoading(levelLoader_t *loader, const char *path);
+
+// true when level is ready (or failed to load), never blocks
+bool isLoaded(const levelLoader_t *loader);
+
+// hands prepared level over, waits for loader if it is still busy
+int takeLevel(levelLoader_t *loader, preparedLevel_t *prepared);
+
+// waits for loader and drops whatever it has prepared
+void stopLoader(levelLoader_t *loader);
+
+#endif //SOKOBAN_LOADER_H
@@ -0,0 +1,53 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stddef.h>
+#include <stdint.h>
+
+#include "level.h"
+
+#ifndef SOKOBAN_SOLVER_H
+#define SOKOBAN_SOLVER_H
+
+// level prepared for search, same padded layout as batchEnv_t but with
+// a single wall border: cell (x, y) has index (y + 1) * stride + x + 1.
+// Boards that fit a width class of kernels.h use class width as stride.
+typedef struct solverMap {
+    int rows, cols, stride, cells, chestNum;
+    int widthClass;             // stride of specialised kernels, 0 for none
+    int offset[4];              // cell offset for each Dir
+
+    uint8_t *wall, *dest;       // [cells]
+    uint8_t *dead;              // [cells] chest standing here can never reach destination
+    uint8_t *startChests;       // [cells]
+    int startPlayer;
+} solverMap_t;
+
+typedef struct solverResult {
+    int solved, pushes;         // pushes of optimal solution when solved
+    long nodes;                 // states expanded
+    long positions;             // deadlock free positions reachable from start, see countPositions()
+    int stateBytes;             // size of packed state, see stateCodec_t
+    size_t memoryBytes;         // peak memory of closed set and open list
+    size_t spilledBytes, loadedBytes;   // traffic to spill file
+} solverResult_t;
+
+int initSolverMap(solverMap_t *map, const level_t *level);
+
+void freeSolverMap(solverMap_t *map);
+
+// marks cells reachable from start without crossing walls or chests,
+// returns the smallest of them, which identifies player area
+int reachable(const solverMap_t *map, const uint8_t *chests, int start, uint8_t *reach);
+
+// A* over pushes guided by heuristic_t, gives up after maxNodes states.
+// Closed set and open list together are kept under memoryCap bytes (0 for no
+// limit), the rest goes to a spill file in spillDir (NULL for tmpfile()).
+int solveLevel(const level_t *level, long maxNodes, size_t memoryCap, const char *spillDir, solverResult_t *result);
+
+// expands every position reachable from start that has no chest on a dead cell
+// and still has a chest to destination matching, the state space a player can
+// wander through. Counts at most maxNodes positions into result->positions.
+int countPositions(const level_t *level, long maxNodes, solverResult_t *result);
+
+#endif //SOKOBAN_SOLVER_H
@@ -0,0 +1,133 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "solver.h"
+
+#ifndef SOKOBAN_STATE_H
+#define SOKOBAN_STATE_H
+
+// search state packed into bytes: one bit for every cell a chest can stand
+// on (floor that is not dead) followed by 16 bit index of player area cell
+typedef struct stateCodec {
+    int chestCells, floorCells, bytes;
+    int *chestBit;              // [cells] bit of cell or -1
+    int *floorIndex;            // [cells] floor index of cell or -1
+    int *floorCell;             // [floorCells] cell of floor index
+    int *bitCell;               // [chestCells] cell of bit
+} stateCodec_t;
+
+int initStateCodec(stateCodec_t *codec, const solverMap_t *map);
+
+void freeStateCodec(stateCodec_t *codec);
+
+void encodeState(const stateCodec_t *codec, const uint8_t *chests, int player, uint8_t *state);
+
+void decodeState(const stateCodec_t *codec, const uint8_t *state, uint8_t *chests, int *player);
+
+// memory of closed set and open list of one search, cap 0 means no limit
+typedef struct memoryBudget {
+    size_t cap, used, peak;
+} memoryBudget_t;
+
+typedef struct spillExtent {
+    int64_t offset;
+    size_t bytes;
+} spillExtent_t;
+
+// one file for everything a search moves out of memory, created in dir
+// (tmpfile() when dir is NULL) on the first write. Offsets are 64 bit and
+// space of released extents is reused before the file grows.
+typedef struct spillFile {
+    FILE *file;
+    const char *dir;
+    std::string path;
+    int64_t end;
+    std::vector<spillExtent_t> holes;   // sorted by offset, never adjacent
+    size_t writtenBytes, readBytes;
+} spillFile_t;
+
+void initSpillFile(spillFile_t *spill, const char *dir);
+
+void freeSpillFile(spillFile_t *spill);
+
+// sorted run of closed states in spill file. Run is searched in place: index
+// gives the block a key can be in and only that block is read.
+typedef struct spillRun {
+    spillExtent_t extent;
+    size_t count;
+    std::vector<uint8_t> index;     // first key of every block
+    std::vector<uint8_t> bloom;     // 10 bits per key
+} spillRun_t;
+
+// closed set. New states go to hash table; when it cannot grow within budget
+// it is written out as sorted run. Runs of similar size are merged, so there
+// are only a few of them and every state is rewritten a logarithmic number of
+// times. Table also keeps states recently found in runs.
+typedef struct stateStore {
+    int keyBytes;
+    memoryBudget_t *budget;
+    spillFile_t *spill;
+
+    uint8_t *keys, *used;           // [capacity] table, used holds SlotState
+    size_t capacity, count;
+    std::vector<spillRun_t> runs;   // oldest (biggest) first
+
+    size_t memoryUsed;              // table, indexes and bloom filters
+    size_t states;                  // distinct states stored
+} stateStore_t;
+
+int initStateStore(stateStore_t *store, int keyBytes, memoryBudget_t *budget, spillFile_t *spill);
+
+void freeStateStore(stateStore_t *store);
+
+// sets isNew to 1 when state was not in store before
+int insertState(stateStore_t *store, const uint8_t *key, int *isNew);
+
+// looks into the table only, never touches spill file
+bool knownState(const stateStore_t *store, const uint8_t *key);
+
+// moves table to a new sorted run
+int flushStates(stateStore_t *store);
+
+// states of one estimate and pushes, taken last in first out. They are kept
+// in chunks of at most 64 KB; whole older chunks are moved to
+// spill file and read back when the ones in memory run out.
+typedef struct openBucket {
+    std::vector<std::vector<uint8_t> > chunks;     // last one is filled and taken from
+    std::vector<spillExtent_t> spilled;             // older than every chunk, newest last
+} openBucket_t;
+
+// A* open list, bucket per estimate and pushes. The lowest estimate is taken
+// first, deeper state on ties. Bound is consistent, so pushes of closed states
+// are optimal.
+typedef struct openList {
+    int keyBytes;
+    memoryBudget_t *budget;
+    spillFile_t *spill;
+
+    std::vector<std::vector<openBucket_t> > buckets;   // [estimate][pushes], last one is never empty
+    size_t first;                   // estimates below are empty
+    size_t count;                   // states in list
+    size_t memoryUsed;              // capacity of chunks
+} openList_t;
+
+void initOpenList(openList_t *open, int keyBytes, memoryBudget_t *budget, spillFile_t *spill);
+
+void freeOpenList(openList_t *open);
+
+void pushState(openList_t *open, int estimate, int pushes, const uint8_t *key);
+
+// takes state with the lowest estimate, returns QUIT when list is empty
+int popState(openList_t *open, int *estimate, int *pushes, uint8_t *key);
+
+// spills open list and closed table until both fit in their budget, with
+// room left for closed table to grow once (one state is closed per expansion)
+int fitMemory(stateStore_t *closed, openList_t *open);
+
+#endif //SOKOBAN_STATE_H
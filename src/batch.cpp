@@ -0,0 +1,183 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/batch.h"
+#include "../include/kernels.h"
+#include "../include/consts.h"
+
+
+static void resetBoard(batchEnv_t *env, int i) {
+    memcpy(env->chests + (size_t)i * env->cells, env->startChests, env->cells);
+    env->player[i] = env->startPlayer;
+    env->atDest[i] = env->startAtDest;
+    env->steps[i] = 0;
+}
+
+
+// legality of every move, branch free and without stores to boards, so
+// boards are independent and the loop stays short. It is not vectorised:
+// each board is read at its own byte offset and there are no byte gathers.
+template<int W>
+static void checkMoves(batchEnv_t *env, const uint8_t *actions) {
+    const int stride = (W ? W : env->stride);
+    const int offset[4] = {-1, -stride, 1, stride};
+    const int cells = env->cells;
+    const uint8_t *wall = env->wall;
+    const uint8_t *chests = env->chests;
+    const int32_t *player = env->player;
+    int32_t *target = env->target;
+    uint8_t *canMove = env->canMove;
+    uint8_t *push = env->push;
+
+    for(int i = 0; i < env->num; i++) {
+        int move = offset[actions[i] & 3];
+        int next = player[i] + move;
+        const uint8_t *board = chests + (size_t)i * cells;
+
+        int isChest = board[next];
+        int blocked = wall[next] | (isChest & (wall[next + move] | board[next + move]));
+
+        target[i] = next;
+        canMove[i] = !blocked;
+        push[i] = isChest & !blocked;
+    }
+}
+
+
+int initBatchEnv(batchEnv_t *env, const level_t *level, int num, int maxSteps) {
+    const board_t *board = &level->board;
+
+    memset(env, 0, sizeof(batchEnv_t));
+
+    if(num <= 0 || level->chestNum <= 0)
+        return ERROR;
+
+    env->num = num;
+    env->maxSteps = (maxSteps > 0 ? maxSteps : INT32_MAX);
+    env->chestNum = level->chestNum;
+    env->rows = board->rows;
+    env->cols = board->cols;
+
+    switch(strideClass(board->cols + 2)) {
+        case 8:
+            env->stride = 8;
+            env->checkMoves = checkMoves<8>;
+            break;
+        case 16:
+            env->stride = 16;
+            env->checkMoves = checkMoves<16>;
+            break;
+        default:
+            env->stride = board->cols + 2;
+            env->checkMoves = checkMoves<0>;
+            break;
+    }
+
+    env->cells = (board->rows + 4) * env->stride;
+
+    for(int dir = LEFT; dir <= DOWN; dir++)
+        env->offset[dir] = dx[dir] + dy[dir] * env->stride;
+
+    env->wall = (uint8_t*)malloc(env->cells);
+    env->dest = (uint8_t*)calloc(env->cells, 1);
+    env->startChests = (uint8_t*)calloc(env->cells, 1);
+
+    memset(env->wall, 1, env->cells);
+
+    for(int row = 0; row < board->rows; row++) {
+        for(int col = 0; col < board->cols; col++) {
+            int cell = (row + 2) * env->stride + col + 1;
+            int type = board->grid[row][col];
+
+            env->wall[cell] = (type == WALL);
+            env->dest[cell] = (type == CHEST_DEST || type == CHEST_AT_DEST);
+            env->startChests[cell] = (type == CHEST || type == CHEST_AT_DEST);
+            env->startAtDest += (type == CHEST_AT_DEST);
+        }
+    }
+
+    env->startPlayer = (level->playerY + 2) * env->stride + level->playerX + 1;
+
+    env->player = (int32_t*)malloc(num * sizeof(int32_t));
+    env->chests = (uint8_t*)malloc((size_t)num * env->cells);
+    env->atDest = (int32_t*)malloc(num * sizeof(int32_t));
+    env->steps = (int32_t*)malloc(num * sizeof(int32_t));
+    env->target = (int32_t*)malloc(num * sizeof(int32_t));
+    env->canMove = (uint8_t*)malloc(num);
+    env->push = (uint8_t*)malloc(num);
+
+    if(env->player == NULL || env->chests == NULL || env->atDest == NULL || env->steps == NULL ||
+       env->target == NULL || env->canMove == NULL || env->push == NULL) {
+        freeBatchEnv(env);
+        return ERROR;
+    }
+
+    resetBatchEnv(env);
+    return SUCCESS;
+}
+
+
+void freeBatchEnv(batchEnv_t *env) {
+    free(env->wall);
+    free(env->dest);
+    free(env->startChests);
+    free(env->player);
+    free(env->chests);
+    free(env->atDest);
+    free(env->steps);
+    free(env->target);
+    free(env->canMove);
+    free(env->push);
+
+    memset(env, 0, sizeof(batchEnv_t));
+}
+
+
+void resetBatchEnv(batchEnv_t *env) {
+    for(int i = 0; i < env->num; i++)
+        resetBoard(env, i);
+}
+
+
+void stepBatchEnv(batchEnv_t *env, const uint8_t *actions,
+                  float *rewards, uint8_t *dones, int32_t *atDest) {
+    const int num = env->num;
+    const int cells = env->cells;
+    const uint8_t *dest = env->dest;
+    const int32_t *player = env->player;
+    const int32_t *target = env->target;
+    const uint8_t *canMove = env->canMove;
+    const uint8_t *push = env->push;
+
+    env->checkMoves(env, actions);
+
+    // apply moves, scatter writes are done board by board
+    for(int i = 0; i < num; i++) {
+        int next = target[i];
+        int behind = 2 * next - player[i];
+        uint8_t *board = env->chests + (size_t)i * cells;
+        int pushed = push[i];
+        int delta = pushed * (dest[behind] - dest[next]);
+
+        board[next] &= !pushed;
+        board[behind] |= pushed;
+
+        env->player[i] = canMove[i] ? next : player[i];
+        env->atDest[i] += delta;
+        env->steps[i]++;
+
+        int won = (env->atDest[i] == env->chestNum);
+        int done = won | (env->steps[i] >= env->maxSteps);
+
+        rewards[i] = STEP_REWARD + delta * CHEST_REWARD + won * WIN_REWARD;
+        dones[i] = done;
+        atDest[i] = env->atDest[i];
+
+        if(done)
+            resetBoard(env, i);
+    }
+}
@@ -0,0 +1,122 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../include/fingerprint.h"
+#include "../include/consts.h"
+
+typedef struct dedupStats {
+    int read, unique, duplicates, malformed;
+} dedupStats_t;
+
+
+static void addToIndex(levelIndex_t *index, FILE *out, const level_t *level, const char *name, dedupStats_t *stats) {
+    char title[MAX_TEXT_LENGTH];
+    uint64_t fingerprint = levelFingerprint(level);
+
+    stats->read++;
+
+    if(!addLevel(index, fingerprint, name)) {
+        stats->duplicates++;
+        printf("%s: same as %s\n", name, findLevel(index, fingerprint));
+        return;
+    }
+
+    stats->unique++;
+
+    if(out != NULL) {
+        snprintf(title, MAX_TEXT_LENGTH, "%016llx %s", (unsigned long long)fingerprint, name);
+        writeLevelXSB(out, level, title);
+    }
+}
+
+
+// levels in loadLevel() format are single .txt files, anything else is read as XSB collection
+static void importFile(levelIndex_t *index, FILE *out, const char *path, dedupStats_t *stats) {
+    level_t level;
+    size_t length = strlen(path);
+
+    if(length > 4 && strcmp(path + length - 4, ".txt") == 0) {
+        if(parseLevel(path, &level)) {
+            stats->malformed++;
+            return;
+        }
+
+        addToIndex(index, out, &level, path, stats);
+        freeLevel(&level);
+        return;
+    }
+
+    FILE *in = fopen(path, "r");
+    if(in == NULL) {
+        printf("cannot read %s\n", path);
+        return;
+    }
+
+    char title[MAX_TEXT_LENGTH], name[MAX_TEXT_LENGTH];
+    int rc, number = 0;
+
+    while((rc = readLevelXSB(in, &level, title)) != QUIT) {
+        number++;
+
+        if(rc == ERROR) {
+            stats->malformed++;
+            continue;
+        }
+
+        snprintf(name, MAX_TEXT_LENGTH, "%s:%d %s", path, number, title);
+        addToIndex(index, out, &level, name, stats);
+        freeLevel(&level);
+    }
+
+    fclose(in);
+}
+
+
+int main(int argc, char **argv) {
+    levelIndex_t index;
+    dedupStats_t stats = {0, 0, 0, 0};
+    const char *indexPath = "../levels/index.txt";
+    const char *outPath = NULL;
+    int first = 1;
+
+    for(; first + 1 < argc && argv[first][0] == '-'; first += 2) {
+        if(strcmp(argv[first], "-i") == 0)
+            indexPath = argv[first + 1];
+        else if(strcmp(argv[first], "-o") == 0)
+            outPath = argv[first + 1];
+        else
+            break;
+    }
+
+    if(first >= argc) {
+        printf("usage: sokoban_dedup [-i index.txt] [-o unique.xsb] files...\n");
+        return ERROR;
+    }
+
+    if(openLevelIndex(&index, indexPath)) {
+        printf("cannot open index %s\n", indexPath);
+        return ERROR;
+    }
+
+    FILE *out = NULL;
+    if(outPath != NULL && (out = fopen(outPath, "w")) == NULL) {
+        printf("cannot write %s\n", outPath);
+        closeLevelIndex(&index);
+        return ERROR;
+    }
+
+    for(int i = first; i < argc; i++)
+        importFile(&index, out, argv[i], &stats);
+
+    if(out != NULL)
+        fclose(out);
+    closeLevelIndex(&index);
+
+    printf("read %d levels: %d new, %d duplicates, %d malformed\n",
+           stats.read, stats.unique, stats.duplicates, stats.malformed);
+    return SUCCESS;
+}
@@ -131,4 +131,65 @@ void drawBoard(const graphics_t *vfx, const player_t *player, const board_t *boa
     }
 
     drawPlayer(vfx, player, topLeftX, topLeftY, t1);
-}
\ No newline at end of file
+}
+
+
+// draw ARGB8888 sprite on ARGB8888 surface, blending by sprite alpha.
+// Unlike SDL_BlitSurface it never writes to sprite, so many threads can share it.
+void blendSurface(SDL_Surface *screen, const SDL_Surface *sprite, int x, int y) {
+    for(int row = 0; row < sprite->h; row++) {
+        const Uint32 *src = (const Uint32 *)((const Uint8 *)sprite->pixels + row * sprite->pitch);
+        Uint32 *dst = (Uint32 *)((Uint8 *)screen->pixels + (y + row) * screen->pitch) + x;
+
+        for(int col = 0; col < sprite->w; col++) {
+            Uint32 alpha = src[col] >> 24;
+
+            if(alpha == 0)
+                continue;
+
+            if(alpha == 0xFF) {
+                dst[col] = src[col];
+                continue;
+            }
+
+            Uint32 rb = ((src[col] & 0xFF00FF) * alpha + (dst[col] & 0xFF00FF) * (0xFF - alpha)) >> 8;
+            Uint32 g = ((src[col] & 0x00FF00) * alpha + (dst[col] & 0x00FF00) * (0xFF - alpha)) >> 8;
+            dst[col] = 0xFF000000 | (rb & 0xFF00FF) | (g & 0x00FF00);
+        }
+    }
+}
+
+
+// draw level with top-left corner in (x, y), one tile per field
+void drawThumbnail(SDL_Surface *screen, const thumbSprites_t *sprites, const level_t *level, int x, int y) {
+    const field_t *field = &sprites->field;
+    const board_t *board = &level->board;
+
+    for(int row = 0; row < board->rows; row++) {
+        for(int col = 0; col < board->cols; col++) {
+            int newX = x + col * sprites->tile;
+            int newY = y + row * sprites->tile;
+
+            blendSurface(screen, field->empty, newX, newY);
+
+            switch(board->grid[row][col]) {
+                case WALL:
+                    blendSurface(screen, field->wall, newX, newY);
+                    break;
+                case CHEST_DEST:
+                    blendSurface(screen, field->chestDest, newX, newY);
+                    break;
+                case CHEST:
+                    blendSurface(screen, field->chest, newX, newY);
+                    break;
+                case CHEST_AT_DEST:
+                    blendSurface(screen, field->chestAtDest, newX, newY);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    blendSurface(screen, sprites->player, x + level->playerX * sprites->tile, y + level->playerY * sprites->tile);
+}
@@ -0,0 +1,176 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../include/fingerprint.h"
+#include "../include/consts.h"
+
+enum Cell {
+    OUTSIDE = 0,
+    FLOOR,
+    DEST,
+    FLOOR_CHEST,
+    DEST_CHEST
+};
+
+
+static void fnv(uint64_t *hash, uint64_t value) {
+    *hash = (*hash ^ value) * 0x100000001B3ULL;
+}
+
+
+// floods area from (x, y), walls always stop it, chests only when blocking is set
+static void flood(const board_t *board, int x, int y, bool blocking, std::vector<uint8_t> *area) {
+    std::vector<int> queue;
+
+    (*area)[y * board->cols + x] = 1;
+    queue.push_back(y * board->cols + x);
+
+    for(size_t head = 0; head < queue.size(); head++) {
+        int cellX = queue[head] % board->cols;
+        int cellY = queue[head] / board->cols;
+
+        for(int dir = LEFT; dir <= DOWN; dir++) {
+            int nextX = cellX + dx[dir], nextY = cellY + dy[dir];
+
+            if(nextX < 0 || nextX >= board->cols || nextY < 0 || nextY >= board->rows)
+                continue;
+
+            int type = board->grid[nextY][nextX];
+            int next = nextY * board->cols + nextX;
+
+            if((*area)[next] || type == WALL || (blocking && (type == CHEST || type == CHEST_AT_DEST)))
+                continue;
+
+            (*area)[next] = 1;
+            queue.push_back(next);
+        }
+    }
+}
+
+
+uint64_t levelFingerprint(const level_t *level) {
+    const board_t *board = &level->board;
+    int rows = board->rows, cols = board->cols;
+    std::vector<uint8_t> inside(rows * cols), walk(rows * cols), cells(rows * cols);
+
+    flood(board, level->playerX, level->playerY, false, &inside);
+    flood(board, level->playerX, level->playerY, true, &walk);
+
+    int top = rows, bottom = -1, left = cols, right = -1;
+    for(int row = 0; row < rows; row++) {
+        for(int col = 0; col < cols; col++) {
+            int type = board->grid[row][col];
+            uint8_t cell = OUTSIDE;
+
+            if(type == CHEST_DEST)
+                cell = DEST;
+            else if(type == CHEST)
+                cell = FLOOR_CHEST;
+            else if(type == CHEST_AT_DEST)
+                cell = DEST_CHEST;
+            else if(type != WALL && inside[row * cols + col])
+                cell = FLOOR;
+
+            cells[row * cols + col] = cell;
+
+            if(cell != OUTSIDE) {
+                top = (row < top ? row : top);
+                bottom = (row > bottom ? row : bottom);
+                left = (col < left ? col : left);
+                right = (col > right ? col : right);
+            }
+        }
+    }
+
+    int height = bottom - top + 1, width = right - left + 1;
+    uint64_t best = UINT64_MAX;
+
+    // 8 symmetries: optional transposition followed by optional flips
+    for(int symmetry = 0; symmetry < 8; symmetry++) {
+        bool transpose = symmetry & 4, flipRows = symmetry & 1, flipCols = symmetry & 2;
+        int outRows = (transpose ? width : height), outCols = (transpose ? height : width);
+        bool playerSeen = false;
+        uint64_t hash = 0xCBF29CE484222325ULL;
+
+        fnv(&hash, outRows);
+        fnv(&hash, outCols);
+
+        for(int outRow = 0; outRow < outRows; outRow++) {
+            for(int outCol = 0; outCol < outCols; outCol++) {
+                int a = (transpose ? outCol : outRow), b = (transpose ? outRow : outCol);
+                int row = top + (flipRows ? height - 1 - a : a);
+                int col = left + (flipCols ? width - 1 - b : b);
+                int cell = row * cols + col;
+
+                // first cell of player area in this orientation stands for player
+                bool player = (!playerSeen && walk[cell]);
+                playerSeen |= player;
+
+                fnv(&hash, cells[cell] + (player ? 8 : 0));
+            }
+        }
+
+        best = (hash < best ? hash : best);
+    }
+
+    return best;
+}
+
+
+int openLevelIndex(levelIndex_t *index, const char *path) {
+    index->file = NULL;
+    index->names.clear();
+
+    if(path == NULL)
+        return SUCCESS;
+
+    index->file = fopen(path, "a+");
+    if(index->file == NULL)
+        return ERROR;
+
+    char line[MAX_TEXT_LENGTH];
+    char name[MAX_TEXT_LENGTH];
+    unsigned long long fingerprint;
+
+    rewind(index->file);
+    while(fgets(line, MAX_TEXT_LENGTH, index->file) != NULL) {
+        if(sscanf(line, "%llx %199[^\n]", &fingerprint, name) == 2)
+            index->names.insert(std::make_pair((uint64_t)fingerprint, std::string(name)));
+    }
+
+    return SUCCESS;
+}
+
+
+void closeLevelIndex(levelIndex_t *index) {
+    if(index->file != NULL)
+        fclose(index->file);
+
+    index->file = NULL;
+    index->names.clear();
+}
+
+
+const char *findLevel(const levelIndex_t *index, uint64_t fingerprint) {
+    std::unordered_map<uint64_t, std::string>::const_iterator it = index->names.find(fingerprint);
+    return (it == index->names.end() ? NULL : it->second.c_str());
+}
+
+
+int addLevel(levelIndex_t *index, uint64_t fingerprint, const char *name) {
+    if(!index->names.insert(std::make_pair(fingerprint, std::string(name))).second)
+        return 0;
+
+    if(index->file != NULL) {
+        fprintf(index->file, "%016llx %s\n", (unsigned long long)fingerprint, name);
+        fflush(index->file);
+    }
+
+    return 1;
+}
@@ -12,13 +12,18 @@
 #include "../include/colors.h"
 #include "../include/consts.h"
 #include "../include/graphics.h"
+#include "../include/level.h"
+#include "../include/heuristic.h"
+#include "../include/loader.h"
 
 extern "C" {
 #include"SDL.h"
 #include"SDL_main.h"
 }
 
-const char LEVEL_NAME[] = "level2";
+// levels are played in this order
+const char *LEVEL_NAMES[] = {"level1", "level2"};
+const int LEVEL_COUNT = sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]);
 
 void freeSurface(SDL_Surface **surface) {
     if(*surface != NULL)
@@ -47,8 +52,19 @@ void freeAssets(graphics_t *vfx) {
     freeSurface(&vfx->winScreen);
 }
 
+void freeCurrentLevel(var_t *game) {
+    level_t level;
+    level.board = game->board;
+    freeLevel(&level);
+    game->board.grid = NULL;
+
+    freeHeuristic(&game->heuristic);
+}
+
 void terminateProgram(var_t *game) {
     freeAssets(&game->vfx);
+    stopLoader(&game->loader);
+    freeCurrentLevel(game);
 
     SDL_FreeSurface(game->vfx.charset);
     SDL_FreeSurface(game->vfx.screen);
@@ -137,6 +153,18 @@ void updateScreen(graphics_t *vfx) {
     SDL_RenderPresent(vfx->renderer);
 }
 
+// win screen drops from the top of the window over the finished board
+void drawWinScreen(var_t *game) {
+    int x = (SCREEN_WIDTH - WIN_SCREEN_WIDTH) / 2;
+    int y = (SCREEN_HEIGHT - WIN_SCREEN_HEIGHT) / 2;
+    float progress = (game->t1 - game->winTime) / (float)WIN_SCREEN_DROP;
+
+    if(progress < 1.0f)
+        y -= (1.0f - progress) * (1.0f - progress) * (y + WIN_SCREEN_HEIGHT);
+
+    drawSurface(game->vfx.screen, game->vfx.winScreen, x, y);
+}
+
 void display(var_t *game) {
     const double worldTime = game->worldTime;
     const double fps = game->fps;
@@ -145,9 +173,9 @@ void display(var_t *game) {
     board_t *board = &game->board;
     const int moves = game->moves;
 
-    char levelName[MAX_LEVEL_NAME_LENGTH];
+    char levelName[MAX_LEVEL_NAME_LENGTH] = "";
     strcat(levelName, "Sokoban: ");
-    strcat(levelName, LEVEL_NAME);
+    strcat(levelName, LEVEL_NAMES[game->levelIndex]);
 
     char text[MAX_TEXT_LENGTH];
 
@@ -160,6 +188,15 @@ void display(var_t *game) {
     sprintf(text, "%s, elapsed time = %.1lf s  %.0lf frames / s moves: %d", levelName, worldTime, fps, moves);
     drawString(vfx->screen, vfx->screen->w / 2 - strlen(text) * 8 / 2, 10, text, vfx->charset);
 
+    if(game->heuristic.bound >= HEURISTIC_INF)
+        sprintf(text, "no way to finish, press n to restart");
+    else
+        sprintf(text, "at least %d pushes left", game->heuristic.bound);
+    drawString(vfx->screen, vfx->screen->w / 2 - strlen(text) * 8 / 2, 22, text, vfx->charset);
+
+    if(game->won)
+        drawWinScreen(game);
+
     updateScreen(vfx);
 
     game->vfx = *vfx;
@@ -243,6 +280,12 @@ void movePlayer(var_t *game, int x, int y) {
 }
 
 
+// cell of (x, y) in solverMap_t layout, used by heuristic
+int mapCell(var_t *game, int x, int y) {
+    return (y + 1) * game->heuristic.stride + x + 1;
+}
+
+
 void changeFieldSprite(var_t *game, int nextX, int nextY) {
     if(game->board.grid[nextY][nextX] == CHEST_DEST) {
         game->board.grid[nextY][nextX] = CHEST_AT_DEST;
@@ -289,6 +332,7 @@ void move(var_t *game, int dir) {
                 game->board.grid[y][x] = EMPTY;
             }
             movePlayer(game, x, y);
+            moveChest(&game->heuristic, mapCell(game, x, y), mapCell(game, nextX, nextY));
         }
     }
 
@@ -300,7 +344,9 @@ void handleEvents(var_t *game) {
     while(SDL_PollEvent(&event)) {
         switch(event.type) {
             case SDL_KEYDOWN:
-                if(event.key.keysym.sym == SDLK_ESCAPE)
+                if(game->won && event.key.keysym.sym != SDLK_ESCAPE)
+                    game->skipWin = 1;
+                else if(event.key.keysym.sym == SDLK_ESCAPE)
                     game->quit = 1;
                 else if(event.key.keysym.sym == SDLK_n) {
                     game->reset = 1;
@@ -322,87 +368,49 @@ void handleEvents(var_t *game) {
     };
 }
 
-int getFieldType(char c) {
-    switch(c) {
-        case ' ':
-            return EMPTY;
-        case '#':
-            return WALL;
-        case 'c':
-            return CHEST;
-        case 'p':
-            return PLAYER;
-        case 'x':
-            return CHEST_DEST;
-        case 'g':
-            return CHEST_AT_DEST;
-        default:
-            return ERROR;
-    }
+void getLevelPath(int index, char *path) {
+    snprintf(path, MAX_TEXT_LENGTH, "../levels/%s.txt", LEVEL_NAMES[index]);
 }
 
+// puts prepared level in place of the current one, no parsing happens here
+void useLevel(var_t *game, preparedLevel_t *prepared) {
+    freeCurrentLevel(game);
 
-void getPlayerPosition(var_t *game, FILE *lvl) {
-    char line[MAX_ROW_LENGTH];
-
-    fgets(line, MAX_ROW_LENGTH, lvl);
-    int tmp = sscanf(line, "%d %d", &game->player.x, &game->player.y);
+    game->board = prepared->level.board;
+    game->heuristic = prepared->heuristic;
+    game->chestNum = prepared->level.chestNum;
+    game->player.x = prepared->level.playerX;
+    game->player.y = prepared->level.playerY;
+    game->levelId = prepared->levelId;
 
-    assert(tmp == 2);
-    assert(game->board.grid[game->player.x][game->player.y] != CHEST);
-    assert(game->board.grid[game->player.x][game->player.y] != WALL);
-    assert(game->board.grid[game->player.x][game->player.y] != CHEST_AT_DEST);
+    char title[MAX_TEXT_LENGTH];
+    sprintf(title, "%s: %s #%016llx", WINDOW_TITLE, LEVEL_NAMES[game->levelIndex], (unsigned long long)game->levelId);
+    SDL_SetWindowTitle(game->vfx.window, title);
 }
 
+// next level is prepared on background thread while current one is played
+void preloadNextLevel(var_t *game) {
+    char levelPath[MAX_TEXT_LENGTH];
 
-int loadLevel(var_t *game) {
-    FILE *lvl;
-    int tmp;
-    char line[MAX_ROW_LENGTH];
-
-    char levelPath[MAX_TEXT_LENGTH] = "../levels/";
-    strcat(levelPath, LEVEL_NAME);
-    strcat(levelPath, ".txt");
-
-    lvl = fopen(levelPath, "r");
-
-    if(lvl == NULL) {
-        return ERROR;
-    }
-
-    fgets(line, MAX_ROW_LENGTH, lvl);
-    tmp = sscanf(line, "%d %d", &game->board.rows, &game->board.cols);
-    assert(tmp == 2);
-
-    game->board.grid = (int**)malloc(game->board.rows * sizeof(int*));
-
-    for(int row = 0; row < game->board.rows; row++) {
+    if(game->levelIndex + 1 >= LEVEL_COUNT)
+        return;
 
-        game->board.grid[row] = (int*)malloc(game->board.cols * sizeof(int));
-        fgets(line, MAX_ROW_LENGTH, lvl);
+    getLevelPath(game->levelIndex + 1, levelPath);
+    startLoading(&game->loader, levelPath);
+}
 
-        for(int col = 0; col < game->board.cols; col++) {
-            tmp = getFieldType(line[col]);
-            assert(tmp != ERROR);
+int loadLevel(var_t *game) {
+    preparedLevel_t prepared;
+    char levelPath[MAX_TEXT_LENGTH];
 
-            if(tmp == CHEST || tmp == CHEST_AT_DEST) {
-                game->chestNum++;
-            }
-//            if(tmp == CHEST_DEST || tmp == CHEST_AT_DEST) {
-//                game->dests.destNum++;
-//            }
+    getLevelPath(game->levelIndex, levelPath);
 
-            game->board.grid[row][col] = tmp;
-        }
+    if(prepareLevel(levelPath, &prepared)) {
+        return ERROR;
     }
 
-
-//    initChests(game);
-
-    getPlayerPosition(game, lvl);
-
-    fclose(lvl);
-    return 0;
+    useLevel(game, &prepared);
+    return SUCCESS;
 }
 
 void initGame(var_t *game) {
@@ -425,6 +433,25 @@ void initGame(var_t *game) {
     game->player.lastFrame = 0;
     game->player.lastUpdate = 0;
     game->player.moveDir = DOWN;
+
+    game->won = 0;
+    game->winTime = 0;
+    game->skipWin = 0;
+}
+
+int nextLevel(var_t *game) {
+    preparedLevel_t prepared;
+
+    if(takeLevel(&game->loader, &prepared)) {
+        return ERROR;
+    }
+
+    initGame(game);
+    game->levelIndex++;
+    useLevel(game, &prepared);
+    preloadNextLevel(game);
+
+    return SUCCESS;
 }
 
 bool isWin(var_t *game) {
@@ -445,6 +472,9 @@ int gameLoop(var_t *game) {
         return ERROR;
     }
 
+    if(game->loader.state == LOADER_IDLE)
+        preloadNextLevel(game);
+
     while(!game->quit) {
         game->t2 = SDL_GetTicks();
 
@@ -454,18 +484,23 @@ int gameLoop(var_t *game) {
         game->delta = (game->t2 - game->t1) * 0.001;
         game->t1 = game->t2;
 
-        if(isWin(game)) {
-            int tmpX = (SCREEN_WIDTH - WIN_SCREEN_WIDTH)/2;
-            int tmpY = (SCREEN_HEIGHT - WIN_SCREEN_HEIGHT)/2;
-            drawSurface(game->vfx.screen, game->vfx.winScreen, tmpX, tmpY);
-            updateScreen(&game->vfx);
+        if(!game->won && isWin(game)) {
+            game->won = 1;
+            game->winTime = game->t2;
+        }
 
-            SDL_Delay(3000);
+        // events are still handled while win screen is shown, switch waits
+        // only for the next level to be ready, which usually already is
+        if(game->won && (game->skipWin || game->t2 - game->winTime >= WIN_SCREEN_TIME)) {
+            if(game->levelIndex + 1 >= LEVEL_COUNT)
+                return QUIT;
 
-            return QUIT;
+            if(isLoaded(&game->loader) && nextLevel(game))
+                return ERROR;
         }
 
-        game->worldTime += game->delta;
+        if(!game->won)
+            game->worldTime += game->delta;
 
         game->fpsTimer += game->delta;
         if(game->fpsTimer > 0.5) {
@@ -488,6 +523,10 @@ int gameLoop(var_t *game) {
 
 int startProgram() {
     var_t game;
+    memset(&game.heuristic, 0, sizeof(heuristic_t));
+    game.board.grid = NULL;
+    game.loader.state = LOADER_IDLE;
+    game.levelIndex = 0;
 
     if(initProgram(&game, &game.vfx)) {
         return ERROR;
@@ -497,7 +536,7 @@ int startProgram() {
 
     int flag = SUCCESS;
 
-    while(flag != QUIT) {
+    while(flag != QUIT && flag != ERROR) {
         flag = gameLoop(&game);
     }
 
@@ -0,0 +1,215 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../include/generator.h"
+#include "../include/fingerprint.h"
+#include "../include/consts.h"
+
+// verified level waiting for ranking
+typedef struct candidate {
+    level_t level;
+    solverResult_t score;
+    uint64_t fingerprint;
+} candidate_t;
+
+typedef struct generatorJob {
+    generatorConfig_t config;
+    int count, poolSize, threads;
+    uint64_t seed;
+    const char *outDir, *xsbPath, *indexPath;
+
+    std::atomic<int> produced;
+    std::atomic<int64_t> attempts;
+    std::mutex lock;
+    levelIndex_t index, pool;
+    std::vector<candidate_t> candidates;
+    FILE *xsb;
+} generatorJob_t;
+
+
+static int saveLevel(generatorJob_t *job, const candidate_t *candidate) {
+    char name[MAX_TEXT_LENGTH], text[MAX_TEXT_LENGTH];
+    snprintf(name, MAX_TEXT_LENGTH, "gen_%016llx", (unsigned long long)candidate->fingerprint);
+    snprintf(text, MAX_TEXT_LENGTH, "%s pushes: %d positions: %ld", name,
+             candidate->score.pushes, candidate->score.positions);
+
+    if(job->xsb != NULL) {
+        writeLevelXSB(job->xsb, &candidate->level, text);
+        addLevel(&job->index, candidate->fingerprint, name);
+        return SUCCESS;
+    }
+
+    char path[MAX_TEXT_LENGTH];
+    snprintf(path, MAX_TEXT_LENGTH, "%s/%s.txt", job->outDir, name);
+
+    FILE *out = fopen(path, "w");
+    if(out == NULL) {
+        printf("cannot write %s\n", path);
+        return ERROR;
+    }
+
+    writeLevel(out, &candidate->level);
+    fclose(out);
+    addLevel(&job->index, candidate->fingerprint, name);
+    return SUCCESS;
+}
+
+
+static void worker(generatorJob_t *job, int index) {
+    uint64_t rng = seedRandom(job->seed, index);
+    const int64_t maxAttempts = (int64_t)job->poolSize * 10000;
+
+    while(job->produced < job->poolSize && job->attempts++ < maxAttempts) {
+        candidate_t candidate;
+
+        if(generateLevel(&job->config, &rng, &candidate.level, &candidate.score))
+            continue;
+
+        candidate.fingerprint = levelFingerprint(&candidate.level);
+        {
+            std::lock_guard<std::mutex> guard(job->lock);
+
+            // pool index only holds this run, index file only levels really written
+            if(job->produced < job->poolSize && findLevel(&job->index, candidate.fingerprint) == NULL &&
+               addLevel(&job->pool, candidate.fingerprint, "")) {
+                job->candidates.push_back(candidate);
+                job->produced++;
+                continue;
+            }
+        }
+
+        freeLevel(&candidate.level);
+    }
+}
+
+
+// most complex first, deeper solution on ties
+static bool moreComplex(const candidate_t &a, const candidate_t &b) {
+    if(a.score.positions != b.score.positions)
+        return a.score.positions > b.score.positions;
+    return a.score.pushes > b.score.pushes;
+}
+
+
+static void usage() {
+    printf("usage: sokoban_gen [-n count] [-j threads] [-s seed] [-r rows] [-c cols]\n"
+           "                   [-b chests] [-p pulls] [-m minPushes] [-d minPositions]\n"
+           "                   [-g poolSize] [-i index.txt] [-o dir | -x file.xsb]\n");
+}
+
+
+int main(int argc, char **argv) {
+    generatorJob_t job;
+
+    job.config.rows = 9;
+    job.config.cols = 9;
+    job.config.chestNum = 3;
+    job.config.pulls = 300;
+    job.config.minPushes = 10;
+    job.config.minPositions = 0;
+    job.config.maxNodes = 1000000;
+    job.count = 100;
+    job.poolSize = 0;
+    job.threads = std::thread::hardware_concurrency();
+    job.seed = time(NULL);
+    job.outDir = "../levels";
+    job.xsbPath = NULL;
+    job.indexPath = NULL;
+    job.produced = 0;
+    job.attempts = 0;
+    job.xsb = NULL;
+
+    for(int i = 1; i < argc; i++) {
+        if(i + 1 >= argc || argv[i][0] != '-') {
+            usage();
+            return ERROR;
+        }
+
+        const char *value = argv[++i];
+        switch(argv[i - 1][1]) {
+            case 'n': job.count = atoi(value); break;
+            case 'j': job.threads = atoi(value); break;
+            case 's': job.seed = strtoull(value, NULL, 10); break;
+            case 'r': job.config.rows = atoi(value); break;
+            case 'c': job.config.cols = atoi(value); break;
+            case 'b': job.config.chestNum = atoi(value); break;
+            case 'p': job.config.pulls = atoi(value); break;
+            case 'm': job.config.minPushes = atoi(value); break;
+            case 'd': job.config.minPositions = atol(value); break;
+            case 'g': job.poolSize = atoi(value); break;
+            case 'o': job.outDir = value; break;
+            case 'x': job.xsbPath = value; break;
+            case 'i': job.indexPath = value; break;
+            default:
+                usage();
+                return ERROR;
+        }
+    }
+
+    if(job.threads <= 0)
+        job.threads = 1;
+
+    // -g generates bigger pool and keeps only the most complex levels of it
+    if(job.poolSize < job.count)
+        job.poolSize = job.count;
+
+    if(job.config.rows < 4 || job.config.cols < 4 || job.config.chestNum <= 0) {
+        usage();
+        return ERROR;
+    }
+
+    // with index file levels generated in earlier runs are skipped too
+    openLevelIndex(&job.pool, NULL);
+    if(openLevelIndex(&job.index, job.indexPath)) {
+        printf("cannot open index %s\n", job.indexPath);
+        closeLevelIndex(&job.pool);
+        return ERROR;
+    }
+
+    if(job.xsbPath != NULL) {
+        job.xsb = fopen(job.xsbPath, "w");
+        if(job.xsb == NULL) {
+            printf("cannot write %s\n", job.xsbPath);
+            closeLevelIndex(&job.index);
+            closeLevelIndex(&job.pool);
+            return ERROR;
+        }
+    }
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < job.threads; i++)
+        threads.push_back(std::thread(worker, &job, i));
+
+    for(size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    std::sort(job.candidates.begin(), job.candidates.end(), moreComplex);
+
+    int saved = 0;
+    for(size_t i = 0; i < job.candidates.size(); i++) {
+        if(saved < job.count && saveLevel(&job, &job.candidates[i]) == SUCCESS)
+            saved++;
+        freeLevel(&job.candidates[i].level);
+    }
+
+    if(job.xsb != NULL)
+        fclose(job.xsb);
+    closeLevelIndex(&job.index);
+    closeLevelIndex(&job.pool);
+
+    printf("generated %d levels in %lld attempts, saved %d most complex\n",
+           (int)job.produced, (long long)job.attempts, saved);
+    return (saved < job.count ? ERROR : SUCCESS);
+}
@@ -0,0 +1,202 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../include/generator.h"
+#include "../include/consts.h"
+
+
+uint64_t seedRandom(uint64_t seed, uint64_t stream) {
+    uint64_t rng = seed ^ (stream * 0x9E3779B97F4A7C15ULL);
+    nextRandom(&rng);
+    return rng;
+}
+
+
+// splitmix64
+uint64_t nextRandom(uint64_t *rng) {
+    uint64_t z = (*rng += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+
+static int randomInt(uint64_t *rng, int n) {
+    return (int)(nextRandom(rng) % (uint64_t)n);
+}
+
+
+static void allocGrid(level_t *level, int rows, int cols) {
+    level->board.rows = rows;
+    level->board.cols = cols;
+    level->board.grid = (int**)malloc(rows * sizeof(int*));
+
+    for(int row = 0; row < rows; row++) {
+        level->board.grid[row] = (int*)malloc(cols * sizeof(int));
+
+        for(int col = 0; col < cols; col++)
+            level->board.grid[row][col] = WALL;
+    }
+}
+
+
+// random walk from the middle of the room, carving floor until half of it is open
+static int carveRoom(level_t *level, uint64_t *rng) {
+    int rows = level->board.rows, cols = level->board.cols;
+    int x = cols / 2, y = rows / 2, dir = randomInt(rng, 4);
+    int floor = 0, target = (rows - 2) * (cols - 2) / 2;
+
+    for(int step = 0; floor < target && step < 100 * target; step++) {
+        if(level->board.grid[y][x] == WALL) {
+            level->board.grid[y][x] = EMPTY;
+            floor++;
+        }
+
+        if(randomInt(rng, 100) < 35)
+            dir = randomInt(rng, 4);
+
+        int nextX = x + dx[dir], nextY = y + dy[dir];
+        if(nextX < 1 || nextX > cols - 2 || nextY < 1 || nextY > rows - 2)
+            continue;
+
+        x = nextX;
+        y = nextY;
+    }
+
+    return floor;
+}
+
+
+static int randomFloor(const level_t *level, uint64_t *rng) {
+    for(;;) {
+        int x = 1 + randomInt(rng, level->board.cols - 2);
+        int y = 1 + randomInt(rng, level->board.rows - 2);
+
+        if(level->board.grid[y][x] == EMPTY)
+            return y * level->board.cols + x;
+    }
+}
+
+
+// player pulls chest from cell to the one he stands on and steps back
+static void reversePlay(const solverMap_t *map, uint8_t *chests, int *player, int pulls, uint64_t *rng) {
+    std::vector<uint8_t> reach(map->cells);
+    std::vector<int> moves;
+
+    for(int pull = 0; pull < pulls; pull++) {
+        reachable(map, chests, *player, reach.data());
+        moves.clear();
+
+        for(int cell = 0; cell < map->cells; cell++) {
+            if(!chests[cell])
+                continue;
+
+            for(int dir = LEFT; dir <= DOWN; dir++) {
+                int stand = cell + map->offset[dir];
+                int back = stand + map->offset[dir];
+
+                if(reach[stand] && !map->wall[back] && !chests[back])
+                    moves.push_back(cell * 4 + dir);
+            }
+        }
+
+        if(moves.empty())
+            break;
+
+        int move = moves[randomInt(rng, moves.size())];
+        int cell = move / 4, offset = map->offset[move % 4];
+
+        chests[cell] = 0;
+        chests[cell + offset] = 1;
+        *player = cell + 2 * offset;
+    }
+
+    // player may start anywhere in his area
+    reachable(map, chests, *player, reach.data());
+    moves.clear();
+    for(int cell = 0; cell < map->cells; cell++) {
+        if(reach[cell])
+            moves.push_back(cell);
+    }
+    *player = moves[randomInt(rng, moves.size())];
+}
+
+
+int generateLevel(const generatorConfig_t *config, uint64_t *rng,
+                  level_t *level, solverResult_t *score) {
+    solverMap_t map;
+    int rows = config->rows, cols = config->cols;
+
+    allocGrid(level, rows, cols);
+    level->chestNum = config->chestNum;
+
+    if(carveRoom(level, rng) < config->chestNum + 2) {
+        freeLevel(level);
+        return ERROR;
+    }
+
+    for(int i = 0; i < config->chestNum; i++) {
+        int cell = randomFloor(level, rng);
+        level->board.grid[cell / cols][cell % cols] = CHEST_AT_DEST;
+    }
+
+    int start = randomFloor(level, rng);
+    level->playerX = start % cols;
+    level->playerY = start / cols;
+
+    initSolverMap(&map, level);
+
+    std::vector<uint8_t> chests(map.startChests, map.startChests + map.cells);
+    int player = map.startPlayer;
+
+    reversePlay(&map, chests.data(), &player, config->pulls, rng);
+
+    for(int row = 0; row < rows; row++) {
+        for(int col = 0; col < cols; col++) {
+            int cell = (row + 1) * map.stride + col + 1;
+
+            if(map.wall[cell])
+                continue;
+
+            if(chests[cell] && map.dest[cell]) {
+                freeSolverMap(&map);
+                freeLevel(level);
+                return ERROR;
+            }
+
+            if(chests[cell])
+                level->board.grid[row][col] = CHEST;
+            else if(map.dest[cell])
+                level->board.grid[row][col] = CHEST_DEST;
+            else
+                level->board.grid[row][col] = EMPTY;
+        }
+    }
+
+    level->playerX = player % map.stride - 1;
+    level->playerY = player / map.stride - 1;
+    if(level->board.grid[level->playerY][level->playerX] == EMPTY)
+        level->board.grid[level->playerY][level->playerX] = PLAYER;
+
+    freeSolverMap(&map);
+
+    if(solveLevel(level, config->maxNodes, 0, NULL, score) || !score->solved || score->pushes < config->minPushes) {
+        freeLevel(level);
+        return ERROR;
+    }
+
+    solverResult_t space;
+    if(countPositions(level, config->maxNodes, &space) || space.positions < config->minPositions) {
+        freeLevel(level);
+        return ERROR;
+    }
+
+    score->positions = space.positions;
+    return SUCCESS;
+}
@@ -0,0 +1,217 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../include/heuristic.h"
+#include "../include/consts.h"
+
+
+// pulls chest away from destination, pulls needed to reach a cell are pushes needed to get back
+static void pushDistances(const solverMap_t *map, int dest, int *distance) {
+    std::vector<int> queue;
+
+    for(int cell = 0; cell < map->cells; cell++)
+        distance[cell] = HEURISTIC_INF;
+
+    distance[dest] = 0;
+    queue.push_back(dest);
+
+    for(size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+
+        for(int dir = LEFT; dir <= DOWN; dir++) {
+            int to = cell + map->offset[dir];
+
+            if(distance[to] != HEURISTIC_INF || map->wall[to] || map->wall[to + map->offset[dir]])
+                continue;
+
+            distance[to] = distance[cell] + 1;
+            queue.push_back(to);
+        }
+    }
+}
+
+
+int initHeuristic(heuristic_t *h, const solverMap_t *map) {
+    memset(h, 0, sizeof(heuristic_t));
+
+    for(int cell = 0; cell < map->cells; cell++)
+        h->destNum += map->dest[cell];
+
+    h->chestNum = map->chestNum;
+    h->size = (h->destNum > h->chestNum ? h->destNum : h->chestNum);
+    h->cells = map->cells;
+    h->stride = map->stride;
+
+    h->distance = (int*)malloc((size_t)h->destNum * h->cells * sizeof(int));
+    h->chestCell = (int*)malloc(h->size * sizeof(int));
+    h->chestAt = (int*)malloc(h->cells * sizeof(int));
+    h->u = (int*)calloc(h->size + 1, sizeof(int));
+    h->v = (int*)calloc(h->size + 1, sizeof(int));
+    h->owner = (int*)calloc(h->size + 1, sizeof(int));
+    h->match = (int*)calloc(h->size + 1, sizeof(int));
+    h->minv = (int*)malloc((h->size + 1) * sizeof(int));
+    h->way = (int*)malloc((h->size + 1) * sizeof(int));
+    h->used = (uint8_t*)malloc(h->size + 1);
+
+    for(int cell = 0, dest = 0; cell < map->cells; cell++) {
+        if(map->dest[cell])
+            pushDistances(map, cell, h->distance + (size_t)dest++ * h->cells);
+    }
+
+    // level can never be finished, nothing is matched and moveChest() does nothing
+    if(h->destNum < h->chestNum) {
+        for(int cell = 0; cell < h->cells; cell++)
+            h->chestAt[cell] = -1;
+        for(int chest = 0; chest < h->size; chest++)
+            h->chestCell[chest] = -1;
+
+        h->bound = HEURISTIC_INF;
+        return ERROR;
+    }
+
+    setChests(h, map->startChests);
+    return SUCCESS;
+}
+
+
+void freeHeuristic(heuristic_t *h) {
+    free(h->distance);
+    free(h->chestCell);
+    free(h->chestAt);
+    free(h->u);
+    free(h->v);
+    free(h->owner);
+    free(h->match);
+    free(h->minv);
+    free(h->way);
+    free(h->used);
+
+    memset(h, 0, sizeof(heuristic_t));
+}
+
+
+// rows and columns are 1-based, as in the classic formulation
+static int cost(const heuristic_t *h, int row, int col) {
+    int cell = h->chestCell[row - 1];
+    return (cell < 0 ? 0 : h->distance[(size_t)(col - 1) * h->cells + cell]);
+}
+
+
+// finds shortest augmenting path from unmatched row, adjusting potentials
+// on the way. Every other row has to be matched, so exactly one column is free.
+static void augment(heuristic_t *h, int row) {
+    int n = h->size;
+    int col0 = 0;
+
+    h->owner[0] = row;
+    h->u[row] = 0;
+    for(int col = 0; col <= n; col++) {
+        h->minv[col] = INT32_MAX;
+        h->used[col] = 0;
+    }
+
+    do {
+        int row0 = h->owner[col0], delta = INT32_MAX, col1 = 0;
+        h->used[col0] = 1;
+
+        for(int col = 1; col <= n; col++) {
+            if(h->used[col])
+                continue;
+
+            int reduced = cost(h, row0, col) - h->u[row0] - h->v[col];
+            if(reduced < h->minv[col]) {
+                h->minv[col] = reduced;
+                h->way[col] = col0;
+            }
+            if(h->minv[col] < delta) {
+                delta = h->minv[col];
+                col1 = col;
+            }
+        }
+
+        for(int col = 0; col <= n; col++) {
+            if(h->used[col]) {
+                h->u[h->owner[col]] += delta;
+                h->v[col] -= delta;
+            }
+            else {
+                h->minv[col] -= delta;
+            }
+        }
+
+        col0 = col1;
+    } while(h->owner[col0] != 0);
+
+    do {
+        int col1 = h->way[col0];
+        h->owner[col0] = h->owner[col1];
+        h->match[h->owner[col0]] = col0;
+        col0 = col1;
+    } while(col0);
+}
+
+
+static void updateBound(heuristic_t *h) {
+    h->bound = 0;
+
+    for(int row = 1; row <= h->size; row++) {
+        h->bound += cost(h, row, h->match[row]);
+        if(h->bound >= HEURISTIC_INF) {
+            h->bound = HEURISTIC_INF;
+            return;
+        }
+    }
+}
+
+
+void setChests(heuristic_t *h, const uint8_t *chests) {
+    int chest = 0;
+
+    for(int cell = 0; cell < h->cells; cell++) {
+        h->chestAt[cell] = -1;
+
+        if(chests[cell] && chest < h->size) {
+            h->chestAt[cell] = chest;
+            h->chestCell[chest++] = cell;
+        }
+    }
+
+    for(; chest < h->size; chest++)
+        h->chestCell[chest] = -1;
+
+    for(int i = 0; i <= h->size; i++)
+        h->u[i] = h->v[i] = h->owner[i] = h->match[i] = 0;
+
+    for(int row = 1; row <= h->size; row++)
+        augment(h, row);
+
+    updateBound(h);
+}
+
+
+void moveChest(heuristic_t *h, int from, int to) {
+    if(h->chestAt == NULL)
+        return;
+
+    int chest = h->chestAt[from];
+
+    if(chest < 0)
+        return;
+
+    h->chestAt[from] = -1;
+    h->chestAt[to] = chest;
+    h->chestCell[chest] = to;
+
+    // drop old match of the chest, other rows stay optimal and feasible
+    h->owner[h->match[chest + 1]] = 0;
+    h->match[chest + 1] = 0;
+
+    augment(h, chest + 1);
+    updateBound(h);
+}
@@ -0,0 +1,303 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "../include/level.h"
+#include "../include/consts.h"
+
+
+int getFieldType(char c) {
+    switch(c) {
+        case ' ':
+            return EMPTY;
+        case '#':
+            return WALL;
+        case 'c':
+            return CHEST;
+        case 'p':
+            return PLAYER;
+        case 'x':
+            return CHEST_DEST;
+        case 'g':
+            return CHEST_AT_DEST;
+        default:
+            return ERROR;
+    }
+}
+
+
+char getFieldChar(int type) {
+    switch(type) {
+        case WALL:
+            return '#';
+        case CHEST:
+            return 'c';
+        case PLAYER:
+            return 'p';
+        case CHEST_DEST:
+            return 'x';
+        case CHEST_AT_DEST:
+            return 'g';
+        default:
+            return ' ';
+    }
+}
+
+
+void freeLevel(level_t *level) {
+    if(level->board.grid == NULL)
+        return;
+
+    for(int row = 0; row < level->board.rows; row++)
+        free(level->board.grid[row]);
+
+    free(level->board.grid);
+    level->board.grid = NULL;
+}
+
+
+// reads level in loadLevel() format, it does not depend on SDL so batch tools can use it
+int parseLevel(const char *path, level_t *level) {
+    FILE *lvl;
+    int tmp;
+    char line[MAX_ROW_LENGTH];
+
+    level->board.grid = NULL;
+    level->board.rows = 0;
+    level->chestNum = 0;
+
+    lvl = fopen(path, "r");
+
+    if(lvl == NULL) {
+        return ERROR;
+    }
+
+    if(fgets(line, MAX_ROW_LENGTH, lvl) == NULL ||
+       sscanf(line, "%d %d", &level->board.rows, &level->board.cols) != 2 ||
+       level->board.rows <= 0 || level->board.cols <= 0 || level->board.cols >= MAX_ROW_LENGTH - 1) {
+        level->board.rows = 0;
+        fclose(lvl);
+        return ERROR;
+    }
+
+    level->board.grid = (int**)calloc(level->board.rows, sizeof(int*));
+
+    for(int row = 0; row < level->board.rows; row++) {
+
+        level->board.grid[row] = (int*)malloc(level->board.cols * sizeof(int));
+
+        if(fgets(line, MAX_ROW_LENGTH, lvl) == NULL) {
+            fclose(lvl);
+            freeLevel(level);
+            return ERROR;
+        }
+
+        for(int col = 0; col < level->board.cols; col++) {
+            tmp = getFieldType(line[col]);
+
+            if(tmp == ERROR) {
+                fclose(lvl);
+                freeLevel(level);
+                return ERROR;
+            }
+
+            if(tmp == CHEST || tmp == CHEST_AT_DEST) {
+                level->chestNum++;
+            }
+
+            level->board.grid[row][col] = tmp;
+        }
+    }
+
+    tmp = (fgets(line, MAX_ROW_LENGTH, lvl) != NULL &&
+           sscanf(line, "%d %d", &level->playerX, &level->playerY) == 2);
+    fclose(lvl);
+
+    if(!tmp ||
+       level->playerX < 0 || level->playerX >= level->board.cols ||
+       level->playerY < 0 || level->playerY >= level->board.rows) {
+        freeLevel(level);
+        return ERROR;
+    }
+
+    tmp = level->board.grid[level->playerY][level->playerX];
+    if(tmp == CHEST || tmp == WALL || tmp == CHEST_AT_DEST) {
+        freeLevel(level);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+void writeLevel(FILE *out, const level_t *level) {
+    fprintf(out, "%d %d\n", level->board.rows, level->board.cols);
+
+    for(int row = 0; row < level->board.rows; row++) {
+        for(int col = 0; col < level->board.cols; col++)
+            fputc(getFieldChar(level->board.grid[row][col]), out);
+        fputc('\n', out);
+    }
+
+    fprintf(out, "%d %d\n", level->playerX, level->playerY);
+}
+
+
+void writeLevelXSB(FILE *out, const level_t *level, const char *title) {
+    if(title != NULL)
+        fprintf(out, "; %s\n\n", title);
+
+    for(int row = 0; row < level->board.rows; row++) {
+        for(int col = 0; col < level->board.cols; col++) {
+            int type = level->board.grid[row][col];
+            bool isPlayer = (row == level->playerY && col == level->playerX);
+
+            switch(type) {
+                case WALL:
+                    fputc('#', out);
+                    break;
+                case CHEST:
+                    fputc('$', out);
+                    break;
+                case CHEST_AT_DEST:
+                    fputc('*', out);
+                    break;
+                case CHEST_DEST:
+                    fputc(isPlayer ? '+' : '.', out);
+                    break;
+                default:
+                    fputc(isPlayer ? '@' : ' ', out);
+                    break;
+            }
+        }
+        fputc('\n', out);
+    }
+
+    fputc('\n', out);
+}
+
+
+static bool isXSBRow(const char *line) {
+    bool hasWall = false;
+
+    for(; *line && *line != '\n' && *line != '\r'; line++) {
+        if(strchr("#@+$*. -_", *line) == NULL)
+            return false;
+        hasWall |= (*line == '#');
+    }
+
+    return hasWall;
+}
+
+
+static bool isXSBTitle(const char *line) {
+    return line[0] == ';' || strncmp(line, "Title:", 6) == 0;
+}
+
+
+static void copyXSBTitle(const char *line, char *title) {
+    const char *text = line + (line[0] == ';' ? 1 : 6);
+    text += strspn(text, " \t");
+    snprintf(title, MAX_TEXT_LENGTH, "%.*s", (int)strcspn(text, "\r\n"), text);
+}
+
+
+int readLevelXSB(FILE *in, level_t *level, char *title) {
+    char line[MAX_TEXT_LENGTH];
+    std::vector<std::string> rows;
+    size_t cols = 0;
+    long start;
+
+    level->board.grid = NULL;
+    level->board.rows = 0;
+    level->chestNum = 0;
+    title[0] = '\0';
+
+    // comments before the board, then the board. Line ending the board is
+    // given back, it may be the title of the next level.
+    while(start = ftell(in), fgets(line, MAX_TEXT_LENGTH, in) != NULL) {
+        if(isXSBRow(line)) {
+            rows.push_back(std::string(line, strcspn(line, "\r\n")));
+            cols = (rows.back().size() > cols ? rows.back().size() : cols);
+            continue;
+        }
+
+        if(!rows.empty()) {
+            fseek(in, start, SEEK_SET);
+            break;
+        }
+
+        if(isXSBTitle(line))
+            copyXSBTitle(line, title);
+    }
+
+    // collections with "Title:" after the board name the level there
+    while(!rows.empty() && title[0] == '\0' && (start = ftell(in), fgets(line, MAX_TEXT_LENGTH, in) != NULL)) {
+        if(isXSBRow(line) || line[0] == ';') {
+            fseek(in, start, SEEK_SET);
+            break;
+        }
+
+        if(isXSBTitle(line))
+            copyXSBTitle(line, title);
+    }
+
+    if(rows.empty())
+        return QUIT;
+
+    int players = 0;
+
+    level->board.rows = rows.size();
+    level->board.cols = cols;
+    level->board.grid = (int**)malloc(rows.size() * sizeof(int*));
+
+    for(size_t row = 0; row < rows.size(); row++) {
+        level->board.grid[row] = (int*)malloc(cols * sizeof(int));
+
+        for(size_t col = 0; col < cols; col++) {
+            char c = (col < rows[row].size() ? rows[row][col] : ' ');
+            int type = EMPTY;
+
+            switch(c) {
+                case '#':
+                    type = WALL;
+                    break;
+                case '$':
+                    type = CHEST;
+                    break;
+                case '*':
+                    type = CHEST_AT_DEST;
+                    break;
+                case '.':
+                case '+':
+                    type = CHEST_DEST;
+                    break;
+                default:
+                    break;
+            }
+
+            if(c == '@' || c == '+') {
+                level->playerX = col;
+                level->playerY = row;
+                players++;
+            }
+
+            level->chestNum += (type == CHEST || type == CHEST_AT_DEST);
+            level->board.grid[row][col] = type;
+        }
+    }
+
+    if(players != 1) {
+        freeLevel(level);
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
@@ -0,0 +1,85 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../include/loader.h"
+#include "../include/fingerprint.h"
+#include "../include/solver.h"
+
+
+int prepareLevel(const char *path, preparedLevel_t *prepared) {
+    solverMap_t map;
+
+    memset(prepared, 0, sizeof(preparedLevel_t));
+
+    if(parseLevel(path, &prepared->level))
+        return ERROR;
+
+    prepared->levelId = levelFingerprint(&prepared->level);
+
+    // push distances are computed once per level, later pushes update matching only
+    // level with more chests than destinations is still played, with
+    // HEURISTIC_INF bound the game shows there is no way to finish it
+    initSolverMap(&map, &prepared->level);
+    if(initHeuristic(&prepared->heuristic, &map))
+        prepared->heuristic.bound = HEURISTIC_INF;
+    freeSolverMap(&map);
+
+    return SUCCESS;
+}
+
+
+void freePreparedLevel(preparedLevel_t *prepared) {
+    freeLevel(&prepared->level);
+    freeHeuristic(&prepared->heuristic);
+}
+
+
+static void loadInBackground(levelLoader_t *loader) {
+    int rc = prepareLevel(loader->path, &loader->prepared);
+    loader->state = (rc == SUCCESS ? LOADER_READY : LOADER_FAILED);
+}
+
+
+void startLoading(levelLoader_t *loader, const char *path) {
+    stopLoader(loader);
+
+    snprintf(loader->path, MAX_TEXT_LENGTH, "%s", path);
+    loader->state = LOADER_BUSY;
+    loader->thread = std::thread(loadInBackground, loader);
+}
+
+
+bool isLoaded(const levelLoader_t *loader) {
+    int state = loader->state;
+    return (state == LOADER_READY || state == LOADER_FAILED);
+}
+
+
+int takeLevel(levelLoader_t *loader, preparedLevel_t *prepared) {
+    if(loader->thread.joinable())
+        loader->thread.join();
+
+    int state = loader->state;
+    loader->state = LOADER_IDLE;
+
+    if(state != LOADER_READY)
+        return ERROR;
+
+    *prepared = loader->prepared;
+    return SUCCESS;
+}
+
+
+void stopLoader(levelLoader_t *loader) {
+    if(loader->thread.joinable())
+        loader->thread.join();
+
+    if(loader->state == LOADER_READY)
+        freePreparedLevel(&loader->prepared);
+
+    loader->state = LOADER_IDLE;
+}
@@ -0,0 +1,69 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/solver.h"
+#include "../include/consts.h"
+
+
+static void solveFile(const char *path, long maxNodes, size_t memoryCap, const char *spillDir) {
+    level_t level;
+    solverResult_t result;
+
+    if(parseLevel(path, &level)) {
+        printf("%s: cannot read level\n", path);
+        return;
+    }
+
+    if(solveLevel(&level, maxNodes, memoryCap, spillDir, &result)) {
+        printf("%s: solver error\n", path);
+        freeLevel(&level);
+        return;
+    }
+
+    if(result.solved)
+        printf("%s: solved in %d pushes", path, result.pushes);
+    else
+        printf("%s: not solved", path);
+
+    // peak covers open list too, so it is more than packed bytes of expanded states
+    printf(", %ld states, %d bytes/state packed, %zu bytes peak memory (%.1f bytes/state), "
+           "%zu bytes spilled, %zu bytes loaded back\n",
+           result.nodes, result.stateBytes, result.memoryBytes,
+           result.nodes ? (double)result.memoryBytes / result.nodes : 0.0, result.spilledBytes, result.loadedBytes);
+
+    freeLevel(&level);
+}
+
+
+int main(int argc, char **argv) {
+    long maxNodes = 10000000;
+    size_t memoryCap = 0;
+    const char *spillDir = ".";
+    int first = 1;
+
+    for(; first + 1 < argc && argv[first][0] == '-'; first += 2) {
+        if(strcmp(argv[first], "-n") == 0)
+            maxNodes = atol(argv[first + 1]);
+        else if(strcmp(argv[first], "-m") == 0)
+            memoryCap = (size_t)atol(argv[first + 1]) << 20;
+        else if(strcmp(argv[first], "-d") == 0)
+            spillDir = argv[first + 1];
+        else
+            break;
+    }
+
+    if(first >= argc) {
+        printf("usage: sokoban_solve [-n maxStates] [-m memoryMB] [-d spillDir] levels...\n");
+        return ERROR;
+    }
+
+    for(int i = first; i < argc; i++)
+        solveFile(argv[i], maxNodes, memoryCap, spillDir);
+
+    return SUCCESS;
+}
@@ -0,0 +1,308 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "../include/solver.h"
+#include "../include/heuristic.h"
+#include "../include/state.h"
+#include "../include/kernels.h"
+#include "../include/consts.h"
+
+
+// chest can be pushed from cell to cell + offset only if it can be pulled back,
+// so cells never reached by pulling chests away from destinations are dead
+static void markDeadCells(solverMap_t *map) {
+    std::vector<int> queue;
+    uint8_t *alive = (uint8_t*)calloc(map->cells, 1);
+
+    for(int cell = 0; cell < map->cells; cell++) {
+        if(map->dest[cell]) {
+            alive[cell] = 1;
+            queue.push_back(cell);
+        }
+    }
+
+    for(size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+
+        for(int dir = LEFT; dir <= DOWN; dir++) {
+            int to = cell + map->offset[dir];
+            int player = to + map->offset[dir];
+
+            if(alive[to] || map->wall[to] || map->wall[player])
+                continue;
+
+            alive[to] = 1;
+            queue.push_back(to);
+        }
+    }
+
+    for(int cell = 0; cell < map->cells; cell++)
+        map->dead[cell] = !alive[cell] && !map->wall[cell];
+
+    free(alive);
+}
+
+
+int initSolverMap(solverMap_t *map, const level_t *level) {
+    const board_t *board = &level->board;
+
+    map->rows = board->rows;
+    map->cols = board->cols;
+    map->widthClass = strideClass((board->rows > board->cols ? board->rows : board->cols) + 2);
+    map->stride = (map->widthClass ? map->widthClass : board->cols + 2);
+    map->cells = (board->rows + 2) * map->stride;
+    map->chestNum = level->chestNum;
+
+    for(int dir = LEFT; dir <= DOWN; dir++)
+        map->offset[dir] = dx[dir] + dy[dir] * map->stride;
+
+    map->wall = (uint8_t*)malloc(map->cells);
+    map->dest = (uint8_t*)calloc(map->cells, 1);
+    map->dead = (uint8_t*)calloc(map->cells, 1);
+    map->startChests = (uint8_t*)calloc(map->cells, 1);
+
+    memset(map->wall, 1, map->cells);
+
+    int destNum = 0;
+    for(int row = 0; row < board->rows; row++) {
+        for(int col = 0; col < board->cols; col++) {
+            int cell = (row + 1) * map->stride + col + 1;
+            int type = board->grid[row][col];
+
+            map->wall[cell] = (type == WALL);
+            map->dest[cell] = (type == CHEST_DEST || type == CHEST_AT_DEST);
+            map->startChests[cell] = (type == CHEST || type == CHEST_AT_DEST);
+            destNum += map->dest[cell];
+        }
+    }
+
+    map->startPlayer = (level->playerY + 1) * map->stride + level->playerX + 1;
+
+    markDeadCells(map);
+
+    if(destNum < map->chestNum)
+        return ERROR;
+
+    return SUCCESS;
+}
+
+
+void freeSolverMap(solverMap_t *map) {
+    free(map->wall);
+    free(map->dest);
+    free(map->dead);
+    free(map->startChests);
+
+    map->wall = map->dest = map->dead = map->startChests = NULL;
+}
+
+
+int reachable(const solverMap_t *map, const uint8_t *chests, int start, uint8_t *reach) {
+    std::vector<int> queue;
+    int smallest = start;
+
+    memset(reach, 0, map->cells);
+    reach[start] = 1;
+    queue.push_back(start);
+
+    for(size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+
+        for(int dir = LEFT; dir <= DOWN; dir++) {
+            int to = cell + map->offset[dir];
+
+            if(reach[to] || map->wall[to] || chests[to])
+                continue;
+
+            reach[to] = 1;
+            smallest = (to < smallest ? to : smallest);
+            queue.push_back(to);
+        }
+    }
+
+    return smallest;
+}
+
+
+static bool isSolved(const solverMap_t *map, const uint8_t *chests) {
+    for(int cell = 0; cell < map->cells; cell++) {
+        if(chests[cell] && !map->dest[cell])
+            return false;
+    }
+    return true;
+}
+
+
+// expansion loop, reachability goes through reachKernel<W> of map's width class.
+// Exhaustive search does not stop at solution and runs until open list is empty.
+template<int W>
+static int search(const solverMap_t *map, stateCodec_t *codec, heuristic_t *h, long maxNodes, size_t memoryCap,
+                  const char *spillDir, bool exhaustive, solverResult_t *result) {
+    const int bytes = codec->bytes;
+    const int offset[4] = {-1, -(W ? W : map->stride), 1, (W ? W : map->stride)};
+    std::vector<uint8_t> chests(map->startChests, map->startChests + map->cells);
+    std::vector<uint8_t> state(bytes), child(bytes);
+    reachKernel<W> reach, area;
+    memoryBudget_t budget = {memoryCap, 0, 0};
+    spillFile_t spill;
+    stateStore_t closed;
+    openList_t open;
+    int rc = SUCCESS;
+
+    initSpillFile(&spill, spillDir);
+    initStateStore(&closed, bytes, &budget, &spill);
+    initOpenList(&open, bytes, &budget, &spill);
+
+    reach.load(map, chests.data());
+    encodeState(codec, chests.data(), reach.fill(map->startPlayer), state.data());
+    pushState(&open, h->bound, 0, state.data());
+
+    while(result->nodes < maxNodes) {
+        int estimate, pushes;
+
+        rc = popState(&open, &estimate, &pushes, state.data());
+        if(rc != SUCCESS) {
+            rc = (rc == QUIT ? SUCCESS : ERROR);
+            break;
+        }
+
+        // bound is consistent, state popped first has its optimal pushes
+        int isNew;
+        if(insertState(&closed, state.data(), &isNew)) {
+            rc = ERROR;
+            break;
+        }
+        if(!isNew)
+            continue;
+
+        result->nodes++;
+
+        int player;
+        decodeState(codec, state.data(), chests.data(), &player);
+
+        if(!exhaustive && isSolved(map, chests.data())) {
+            result->solved = 1;
+            result->pushes = pushes;
+            break;
+        }
+
+        reach.load(map, chests.data());
+        reach.fill(player);
+        area = reach;
+        setChests(h, chests.data());
+
+        for(int cell = 0; cell < map->cells; cell++) {
+            if(!chests[cell])
+                continue;
+
+            for(int dir = LEFT; dir <= DOWN; dir++) {
+                int from = cell - offset[dir];
+                int to = cell + offset[dir];
+
+                if(!reach.reached(from) || map->wall[to] || chests[to] || map->dead[to])
+                    continue;
+
+                moveChest(h, cell, to);
+                int bound = h->bound;
+                moveChest(h, to, cell);
+
+                if(bound >= HEURISTIC_INF)
+                    continue;
+
+                chests[cell] = 0;
+                chests[to] = 1;
+                area.move(cell, to);
+
+                encodeState(codec, chests.data(), area.fill(cell), child.data());
+
+                area.move(to, cell);
+                chests[to] = 0;
+                chests[cell] = 1;
+
+                if(!knownState(&closed, child.data()))
+                    pushState(&open, pushes + 1 + bound, pushes + 1, child.data());
+            }
+        }
+
+        if(fitMemory(&closed, &open)) {
+            rc = ERROR;
+            break;
+        }
+    }
+
+    result->memoryBytes = budget.peak;
+    result->spilledBytes = spill.writtenBytes;
+    result->loadedBytes = spill.readBytes;
+
+    freeOpenList(&open);
+    freeStateStore(&closed);
+    freeSpillFile(&spill);
+    return rc;
+}
+
+
+static int runSearch(const level_t *level, long maxNodes, size_t memoryCap, const char *spillDir, bool exhaustive,
+                     solverResult_t *result) {
+    solverMap_t map;
+    stateCodec_t codec;
+    heuristic_t h;
+
+    memset(result, 0, sizeof(solverResult_t));
+
+    if(initSolverMap(&map, level)) {
+        freeSolverMap(&map);
+        return ERROR;
+    }
+
+    if(initStateCodec(&codec, &map)) {
+        freeStateCodec(&codec);
+        freeSolverMap(&map);
+        return ERROR;
+    }
+
+    result->stateBytes = codec.bytes;
+
+    if(initHeuristic(&h, &map) || h.bound >= HEURISTIC_INF) {
+        freeHeuristic(&h);
+        freeStateCodec(&codec);
+        freeSolverMap(&map);
+        return SUCCESS;
+    }
+
+    int rc;
+    switch(map.widthClass) {
+        case 8:
+            rc = search<8>(&map, &codec, &h, maxNodes, memoryCap, spillDir, exhaustive, result);
+            break;
+        case 16:
+            rc = search<16>(&map, &codec, &h, maxNodes, memoryCap, spillDir, exhaustive, result);
+            break;
+        default:
+            rc = search<0>(&map, &codec, &h, maxNodes, memoryCap, spillDir, exhaustive, result);
+            break;
+    }
+
+    freeHeuristic(&h);
+    freeStateCodec(&codec);
+    freeSolverMap(&map);
+    return rc;
+}
+
+
+int solveLevel(const level_t *level, long maxNodes, size_t memoryCap, const char *spillDir, solverResult_t *result) {
+    return runSearch(level, maxNodes, memoryCap, spillDir, false, result);
+}
+
+
+int countPositions(const level_t *level, long maxNodes, solverResult_t *result) {
+    int rc = runSearch(level, maxNodes, 0, NULL, true, result);
+
+    result->positions = result->nodes;
+    return rc;
+}
@@ -0,0 +1,776 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "../include/state.h"
+#include "../include/consts.h"
+
+const size_t FIRST_CAPACITY = 64;
+const size_t SPILL_BUFFER = 1 << 16;   // file io unit of merges, open list chunk
+const size_t BLOCK_BYTES = 64;         // read from a run for one lookup, index keeps a key per block
+const int BLOOM_BITS = 10;             // per spilled state, about 1% false positives
+const int BLOOM_PROBES = 7;
+
+enum SlotState {
+    SLOT_EMPTY = 0,
+    SLOT_NEW = 1,       // goes to the next run
+    SLOT_SPILLED = 2    // copy of state found in a run, dropped at flush
+};
+
+
+int initStateCodec(stateCodec_t *codec, const solverMap_t *map) {
+    codec->chestCells = 0;
+    codec->floorCells = 0;
+    codec->chestBit = (int*)malloc(map->cells * sizeof(int));
+    codec->floorIndex = (int*)malloc(map->cells * sizeof(int));
+    codec->floorCell = (int*)malloc(map->cells * sizeof(int));
+    codec->bitCell = (int*)malloc(map->cells * sizeof(int));
+
+    for(int cell = 0; cell < map->cells; cell++) {
+        codec->chestBit[cell] = -1;
+        codec->floorIndex[cell] = -1;
+
+        if(map->wall[cell])
+            continue;
+
+        codec->floorCell[codec->floorCells] = cell;
+        codec->floorIndex[cell] = codec->floorCells++;
+
+        if(!map->dead[cell]) {
+            codec->bitCell[codec->chestCells] = cell;
+            codec->chestBit[cell] = codec->chestCells++;
+        }
+    }
+
+    codec->bytes = (codec->chestCells + 7) / 8 + 2;
+
+    if(codec->floorCells > UINT16_MAX)
+        return ERROR;
+
+    return SUCCESS;
+}
+
+
+void freeStateCodec(stateCodec_t *codec) {
+    free(codec->chestBit);
+    free(codec->floorIndex);
+    free(codec->floorCell);
+    free(codec->bitCell);
+
+    codec->chestBit = codec->floorIndex = codec->floorCell = codec->bitCell = NULL;
+}
+
+
+void encodeState(const stateCodec_t *codec, const uint8_t *chests, int player, uint8_t *state) {
+    memset(state, 0, codec->bytes);
+
+    for(int bit = 0; bit < codec->chestCells; bit++) {
+        if(chests[codec->bitCell[bit]])
+            state[bit / 8] |= (uint8_t)(1 << (bit % 8));
+    }
+
+    int floor = codec->floorIndex[player];
+    state[codec->bytes - 2] = (uint8_t)(floor & 0xFF);
+    state[codec->bytes - 1] = (uint8_t)(floor >> 8);
+}
+
+
+void decodeState(const stateCodec_t *codec, const uint8_t *state, uint8_t *chests, int *player) {
+    for(int bit = 0; bit < codec->chestCells; bit++)
+        chests[codec->bitCell[bit]] = (state[bit / 8] >> (bit % 8)) & 1;
+
+    *player = codec->floorCell[state[codec->bytes - 2] | (state[codec->bytes - 1] << 8)];
+}
+
+
+static uint64_t hashKey(const uint8_t *key, int bytes) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for(int i = 0; i < bytes; i++)
+        hash = (hash ^ key[i]) * 0x100000001B3ULL;
+
+    // fmix64, so the bottom (slot) bits depend on every byte
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+
+static void charge(memoryBudget_t *budget, size_t *used, size_t bytes) {
+    *used += bytes;
+    budget->used += bytes;
+    budget->peak = (budget->used > budget->peak ? budget->used : budget->peak);
+}
+
+
+static void release(memoryBudget_t *budget, size_t *used, size_t bytes) {
+    *used -= bytes;
+    budget->used -= bytes;
+}
+
+
+void initSpillFile(spillFile_t *spill, const char *dir) {
+    spill->file = NULL;
+    spill->dir = dir;
+    spill->path.clear();
+    spill->end = 0;
+    spill->holes.clear();
+    spill->writtenBytes = spill->readBytes = 0;
+}
+
+
+void freeSpillFile(spillFile_t *spill) {
+    if(spill->file != NULL) {
+        fclose(spill->file);
+        if(!spill->path.empty())
+            remove(spill->path.c_str());
+    }
+
+    initSpillFile(spill, spill->dir);
+}
+
+
+static int openSpillFile(spillFile_t *spill) {
+    static std::atomic<unsigned> created(0);
+
+    if(spill->file != NULL)
+        return SUCCESS;
+
+    if(spill->dir == NULL) {
+        spill->file = tmpfile();
+    }
+    else {
+        char path[MAX_TEXT_LENGTH];
+        snprintf(path, MAX_TEXT_LENGTH, "%s/sokoban_%llx_%u.spill", spill->dir,
+                 (unsigned long long)time(NULL) ^ (unsigned long long)(uintptr_t)spill, created++);
+
+        spill->path = path;
+        spill->file = fopen(path, "w+b");
+    }
+
+    if(spill->file == NULL)
+        return ERROR;
+
+    // reads are single blocks at random offsets, stdio buffer would only read more
+    setvbuf(spill->file, NULL, _IONBF, 0);
+    return SUCCESS;
+}
+
+
+static int seekSpill(FILE *file, int64_t offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+
+static int writeSpill(spillFile_t *spill, int64_t offset, const uint8_t *data, size_t bytes) {
+    if(openSpillFile(spill) || seekSpill(spill->file, offset) != 0 || fwrite(data, 1, bytes, spill->file) != bytes)
+        return ERROR;
+
+    spill->writtenBytes += bytes;
+    return SUCCESS;
+}
+
+
+static int readSpill(spillFile_t *spill, int64_t offset, uint8_t *data, size_t bytes) {
+    if(seekSpill(spill->file, offset) != 0 || fread(data, 1, bytes, spill->file) != bytes)
+        return ERROR;
+
+    spill->readBytes += bytes;
+    return SUCCESS;
+}
+
+
+// first hole that is big enough, end of file otherwise
+static spillExtent_t allocExtent(spillFile_t *spill, size_t bytes) {
+    spillExtent_t extent = {spill->end, bytes};
+
+    for(size_t i = 0; i < spill->holes.size(); i++) {
+        spillExtent_t *hole = &spill->holes[i];
+
+        if(hole->bytes < bytes)
+            continue;
+
+        extent.offset = hole->offset;
+        hole->offset += bytes;
+        hole->bytes -= bytes;
+        if(hole->bytes == 0)
+            spill->holes.erase(spill->holes.begin() + i);
+        return extent;
+    }
+
+    spill->end += bytes;
+    return extent;
+}
+
+
+static void releaseExtent(spillFile_t *spill, spillExtent_t extent) {
+    if(extent.bytes == 0)
+        return;
+
+    std::vector<spillExtent_t> &holes = spill->holes;
+    size_t i = 0;
+    while(i < holes.size() && holes[i].offset < extent.offset)
+        i++;
+    holes.insert(holes.begin() + i, extent);
+
+    if(i + 1 < holes.size() && holes[i].offset + (int64_t)holes[i].bytes == holes[i + 1].offset) {
+        holes[i].bytes += holes[i + 1].bytes;
+        holes.erase(holes.begin() + i + 1);
+    }
+    if(i > 0 && holes[i - 1].offset + (int64_t)holes[i - 1].bytes == holes[i].offset) {
+        holes[i - 1].bytes += holes[i].bytes;
+        holes.erase(holes.begin() + i);
+    }
+
+    if(!holes.empty() && holes.back().offset + (int64_t)holes.back().bytes == spill->end) {
+        spill->end = holes.back().offset;
+        holes.pop_back();
+    }
+}
+
+
+static size_t tableBytes(const stateStore_t *store, size_t capacity) {
+    return capacity * (store->keyBytes + 1);
+}
+
+
+static size_t runBytes(const spillRun_t *run) {
+    return run->index.size() + run->bloom.size();
+}
+
+
+static size_t blockKeys(const stateStore_t *store) {
+    size_t keys = BLOCK_BYTES / store->keyBytes;
+    return (keys > 0 ? keys : 1);
+}
+
+
+// returns slot holding key, or the empty slot where it belongs
+static size_t findSlot(const stateStore_t *store, const uint8_t *key, uint64_t hash) {
+    size_t mask = store->capacity - 1;
+    size_t slot = hash & mask;
+
+    while(store->used[slot] && memcmp(store->keys + slot * store->keyBytes, key, store->keyBytes) != 0)
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+
+static void allocTable(stateStore_t *store, size_t capacity) {
+    store->capacity = capacity;
+    store->count = 0;
+    store->keys = (uint8_t*)malloc(capacity * store->keyBytes);
+    store->used = (uint8_t*)calloc(capacity, 1);
+    charge(store->budget, &store->memoryUsed, tableBytes(store, capacity));
+}
+
+
+static void freeTable(stateStore_t *store) {
+    release(store->budget, &store->memoryUsed, tableBytes(store, store->capacity));
+
+    free(store->keys);
+    free(store->used);
+    store->keys = store->used = NULL;
+    store->capacity = store->count = 0;
+}
+
+
+static void growTable(stateStore_t *store) {
+    uint8_t *keys = store->keys, *used = store->used;
+    size_t capacity = store->capacity;
+    const int bytes = store->keyBytes;
+
+    allocTable(store, capacity * 2);
+
+    for(size_t slot = 0; slot < capacity; slot++) {
+        if(!used[slot])
+            continue;
+
+        const uint8_t *key = keys + slot * bytes;
+        size_t to = findSlot(store, key, hashKey(key, bytes));
+
+        memcpy(store->keys + to * bytes, key, bytes);
+        store->used[to] = used[slot];
+        store->count++;
+    }
+
+    release(store->budget, &store->memoryUsed, tableBytes(store, capacity));
+    free(keys);
+    free(used);
+}
+
+
+static size_t bloomBit(const spillRun_t *run, uint64_t hash, int probe) {
+    uint64_t second = (hash >> 32) | 1;
+    return (size_t)((hash + probe * second) & (run->bloom.size() * 8 - 1));
+}
+
+
+static bool inBloom(const spillRun_t *run, const uint8_t *key, int bytes) {
+    uint64_t hash = hashKey(key, bytes) * 0x9E3779B97F4A7C15ULL;
+
+    for(int probe = 0; probe < BLOOM_PROBES; probe++) {
+        size_t bit = bloomBit(run, hash, probe);
+        if(!(run->bloom[bit / 8] & (1 << (bit % 8))))
+            return false;
+    }
+
+    return true;
+}
+
+
+// sets found when key is in run. Bloom filter answers most misses, otherwise
+// one block chosen by index is read and searched.
+static int findInRun(stateStore_t *store, const spillRun_t *run, const uint8_t *key, bool *found) {
+    const int bytes = store->keyBytes;
+    size_t blocks = run->index.size() / bytes;
+
+    *found = false;
+    if(!inBloom(run, key, bytes))
+        return SUCCESS;
+
+    // blocks starting with key or smaller one
+    size_t low = 0, high = blocks;
+    while(low < high) {
+        size_t middle = (low + high) / 2;
+
+        if(memcmp(&run->index[middle * bytes], key, bytes) <= 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if(low == 0)
+        return SUCCESS;
+
+    size_t first = (low - 1) * blockKeys(store);
+    size_t count = std::min(blockKeys(store), run->count - first);
+    std::vector<uint8_t> block(count * bytes);
+
+    if(readSpill(store->spill, run->extent.offset + (int64_t)(first * bytes), block.data(), block.size()))
+        return ERROR;
+
+    low = 0;
+    high = count;
+    while(low < high) {
+        size_t middle = (low + high) / 2;
+        int order = memcmp(&block[middle * bytes], key, bytes);
+
+        if(order == 0) {
+            *found = true;
+            return SUCCESS;
+        }
+
+        if(order < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return SUCCESS;
+}
+
+
+// streams sorted keys into a new run, building its index and bloom filter
+typedef struct runWriter {
+    spillRun_t run;
+    size_t written, flushed;
+    std::vector<uint8_t> buffer;
+} runWriter_t;
+
+
+static void startRun(stateStore_t *store, runWriter_t *writer, size_t count) {
+    size_t bloom = 8;
+    while(bloom < count * BLOOM_BITS / 8)
+        bloom *= 2;
+
+    writer->run.extent = allocExtent(store->spill, count * store->keyBytes);
+    writer->run.count = count;
+    writer->run.index.clear();
+    writer->run.bloom.assign(bloom, 0);
+    writer->written = writer->flushed = 0;
+    writer->buffer.clear();
+}
+
+
+static int flushWriter(stateStore_t *store, runWriter_t *writer) {
+    if(writeSpill(store->spill, writer->run.extent.offset + (int64_t)writer->flushed,
+                  writer->buffer.data(), writer->buffer.size()))
+        return ERROR;
+
+    writer->flushed += writer->buffer.size();
+    writer->buffer.clear();
+    return SUCCESS;
+}
+
+
+static int addToRun(stateStore_t *store, runWriter_t *writer, const uint8_t *key) {
+    const int bytes = store->keyBytes;
+
+    if(writer->written++ % blockKeys(store) == 0)
+        writer->run.index.insert(writer->run.index.end(), key, key + bytes);
+
+    uint64_t hash = hashKey(key, bytes) * 0x9E3779B97F4A7C15ULL;
+    for(int probe = 0; probe < BLOOM_PROBES; probe++) {
+        size_t bit = bloomBit(&writer->run, hash, probe);
+        writer->run.bloom[bit / 8] |= (uint8_t)(1 << (bit % 8));
+    }
+
+    writer->buffer.insert(writer->buffer.end(), key, key + bytes);
+    return (writer->buffer.size() >= SPILL_BUFFER ? flushWriter(store, writer) : SUCCESS);
+}
+
+
+static int finishRun(stateStore_t *store, runWriter_t *writer) {
+    if(!writer->buffer.empty() && flushWriter(store, writer))
+        return ERROR;
+
+    writer->run.index.shrink_to_fit();
+    charge(store->budget, &store->memoryUsed, runBytes(&writer->run));
+    store->runs.push_back(writer->run);
+    return SUCCESS;
+}
+
+
+static void dropRun(stateStore_t *store, size_t i) {
+    release(store->budget, &store->memoryUsed, runBytes(&store->runs[i]));
+    releaseExtent(store->spill, store->runs[i].extent);
+    store->runs.erase(store->runs.begin() + i);
+}
+
+
+typedef struct runReader {
+    const spillRun_t *run;
+    size_t read, position;
+    std::vector<uint8_t> buffer;
+} runReader_t;
+
+
+// next key of run or NULL at its end
+static int nextKey(stateStore_t *store, runReader_t *reader, const uint8_t **key) {
+    const int bytes = store->keyBytes;
+
+    if(reader->position * bytes == reader->buffer.size()) {
+        size_t count = std::min(SPILL_BUFFER / bytes + 1, reader->run->count - reader->read);
+
+        reader->buffer.resize(count * bytes);
+        reader->position = 0;
+        if(count > 0 && readSpill(store->spill, reader->run->extent.offset + (int64_t)(reader->read * bytes),
+                                  reader->buffer.data(), reader->buffer.size()))
+            return ERROR;
+
+        reader->read += count;
+    }
+
+    *key = (reader->buffer.empty() ? NULL : &reader->buffer[reader->position * bytes]);
+    return SUCCESS;
+}
+
+
+// runs never share a key, merged run is as long as both together
+static int mergeLastRuns(stateStore_t *store) {
+    size_t older = store->runs.size() - 2;
+    runReader_t readers[2];
+    runWriter_t writer;
+    const uint8_t *keys[2];
+
+    startRun(store, &writer, store->runs[older].count + store->runs[older + 1].count);
+
+    for(int i = 0; i < 2; i++) {
+        readers[i].run = &store->runs[older + i];
+        readers[i].read = readers[i].position = 0;
+        if(nextKey(store, &readers[i], &keys[i]))
+            return ERROR;
+    }
+
+    while(keys[0] != NULL || keys[1] != NULL) {
+        int i = (keys[1] == NULL || (keys[0] != NULL && memcmp(keys[0], keys[1], store->keyBytes) < 0) ? 0 : 1);
+
+        if(addToRun(store, &writer, keys[i]))
+            return ERROR;
+
+        readers[i].position++;
+        if(nextKey(store, &readers[i], &keys[i]))
+            return ERROR;
+    }
+
+    dropRun(store, older + 1);
+    dropRun(store, older);
+    return finishRun(store, &writer);
+}
+
+
+int flushStates(stateStore_t *store) {
+    const int bytes = store->keyBytes;
+    std::vector<const uint8_t*> order;
+    runWriter_t writer;
+
+    for(size_t slot = 0; slot < store->capacity; slot++) {
+        if(store->used[slot] == SLOT_NEW)
+            order.push_back(store->keys + slot * bytes);
+    }
+
+    if(order.empty()) {
+        freeTable(store);
+        allocTable(store, FIRST_CAPACITY);
+        return SUCCESS;
+    }
+
+    std::sort(order.begin(), order.end(), [bytes](const uint8_t *a, const uint8_t *b) {
+        return memcmp(a, b, bytes) < 0;
+    });
+
+    startRun(store, &writer, order.size());
+    for(size_t i = 0; i < order.size(); i++) {
+        if(addToRun(store, &writer, order[i]))
+            return ERROR;
+    }
+
+    freeTable(store);
+    if(finishRun(store, &writer))
+        return ERROR;
+    allocTable(store, FIRST_CAPACITY);
+
+    // like carry in binary counter: every state is merged about log(states / table) times
+    while(store->runs.size() >= 2 && store->runs[store->runs.size() - 2].count <= 2 * store->runs.back().count) {
+        if(mergeLastRuns(store))
+            return ERROR;
+    }
+
+    return SUCCESS;
+}
+
+
+int initStateStore(stateStore_t *store, int keyBytes, memoryBudget_t *budget, spillFile_t *spill) {
+    store->keyBytes = keyBytes;
+    store->budget = budget;
+    store->spill = spill;
+    store->memoryUsed = 0;
+    store->states = 0;
+    store->runs.clear();
+
+    allocTable(store, FIRST_CAPACITY);
+    return SUCCESS;
+}
+
+
+void freeStateStore(stateStore_t *store) {
+    while(!store->runs.empty())
+        dropRun(store, store->runs.size() - 1);
+
+    freeTable(store);
+}
+
+
+int insertState(stateStore_t *store, const uint8_t *key, int *isNew) {
+    uint64_t hash = hashKey(key, store->keyBytes);
+    size_t slot = findSlot(store, key, hash);
+
+    *isNew = 0;
+    if(store->used[slot])
+        return SUCCESS;
+
+    // states are pushed by several parents, so one found in a run is kept in
+    // table and its next copies are answered (or not pushed at all) without io
+    int found = SLOT_NEW;
+    for(size_t i = store->runs.size(); i-- > 0 && found == SLOT_NEW; ) {
+        bool inRun;
+
+        if(findInRun(store, &store->runs[i], key, &inRun))
+            return ERROR;
+        found = (inRun ? SLOT_SPILLED : SLOT_NEW);
+    }
+
+    memcpy(store->keys + slot * store->keyBytes, key, store->keyBytes);
+    store->used[slot] = (uint8_t)found;
+    store->count++;
+    store->states += (found == SLOT_NEW);
+    *isNew = (found == SLOT_NEW);
+
+    if(store->count * 4 < store->capacity * 3)
+        return SUCCESS;
+
+    // bigger table would not fit, it goes to spill file instead
+    memoryBudget_t *budget = store->budget;
+    if(budget->cap > 0 && budget->used + tableBytes(store, store->capacity * 2) > budget->cap)
+        return flushStates(store);
+
+    growTable(store);
+    return SUCCESS;
+}
+
+
+bool knownState(const stateStore_t *store, const uint8_t *key) {
+    return store->used[findSlot(store, key, hashKey(key, store->keyBytes))] != SLOT_EMPTY;
+}
+
+
+void initOpenList(openList_t *open, int keyBytes, memoryBudget_t *budget, spillFile_t *spill) {
+    open->keyBytes = keyBytes;
+    open->budget = budget;
+    open->spill = spill;
+    open->buckets.clear();
+    open->first = 0;
+    open->count = 0;
+    open->memoryUsed = 0;
+}
+
+
+void freeOpenList(openList_t *open) {
+    release(open->budget, &open->memoryUsed, open->memoryUsed);
+    open->buckets.clear();
+    open->count = 0;
+}
+
+
+static bool isEmpty(const openBucket_t *bucket) {
+    return bucket->chunks.empty() && bucket->spilled.empty();
+}
+
+
+// chunk never grows over SPILL_BUFFER, so one push takes at most that much memory
+void pushState(openList_t *open, int estimate, int pushes, const uint8_t *key) {
+    if((size_t)estimate >= open->buckets.size())
+        open->buckets.resize(estimate + 1);
+    if((size_t)pushes >= open->buckets[estimate].size())
+        open->buckets[estimate].resize(pushes + 1);
+    open->first = ((size_t)estimate < open->first ? estimate : open->first);
+
+    openBucket_t *bucket = &open->buckets[estimate][pushes];
+    if(bucket->chunks.empty() || bucket->chunks.back().size() + open->keyBytes > SPILL_BUFFER)
+        bucket->chunks.push_back(std::vector<uint8_t>());
+
+    std::vector<uint8_t> &chunk = bucket->chunks.back();
+    size_t before = chunk.capacity();
+
+    if(chunk.size() + open->keyBytes > chunk.capacity())
+        chunk.reserve(std::min(std::max(2 * chunk.capacity(), (size_t)open->keyBytes), SPILL_BUFFER));
+
+    chunk.insert(chunk.end(), key, key + open->keyBytes);
+    charge(open->budget, &open->memoryUsed, chunk.capacity() - before);
+    open->count++;
+}
+
+
+int popState(openList_t *open, int *estimate, int *pushes, uint8_t *key) {
+    while(open->first < open->buckets.size() && open->buckets[open->first].empty())
+        open->first++;
+
+    if(open->first >= open->buckets.size())
+        return QUIT;
+
+    std::vector<openBucket_t> &row = open->buckets[open->first];
+    openBucket_t *bucket = &row.back();
+
+    if(bucket->chunks.empty()) {
+        spillExtent_t extent = bucket->spilled.back();
+
+        bucket->spilled.pop_back();
+        bucket->chunks.push_back(std::vector<uint8_t>(extent.bytes));
+        charge(open->budget, &open->memoryUsed, bucket->chunks.back().capacity());
+
+        if(readSpill(open->spill, extent.offset, bucket->chunks.back().data(), extent.bytes))
+            return ERROR;
+        releaseExtent(open->spill, extent);
+    }
+
+    std::vector<uint8_t> &chunk = bucket->chunks.back();
+    size_t end = chunk.size() - open->keyBytes;
+
+    memcpy(key, &chunk[end], open->keyBytes);
+    chunk.resize(end);
+
+    *estimate = (int)open->first;
+    *pushes = (int)row.size() - 1;
+    open->count--;
+
+    if(chunk.empty()) {
+        release(open->budget, &open->memoryUsed, chunk.capacity());
+        bucket->chunks.pop_back();
+    }
+
+    while(!row.empty() && isEmpty(&row.back()))
+        row.pop_back();
+
+    return SUCCESS;
+}
+
+
+// moves the oldest chunk of the bucket taken last (highest estimate, fewest
+// pushes) to spill file. Chunk being taken from stays. With current=false
+// only estimates above the current one are looked at. Sets spilled when it
+// did anything.
+static int spillOpenList(openList_t *open, bool current, bool *spilled) {
+    *spilled = false;
+
+    for(size_t estimate = open->buckets.size(); estimate-- > open->first; ) {
+        std::vector<openBucket_t> &row = open->buckets[estimate];
+
+        if(estimate == open->first && !current)
+            break;
+
+        for(size_t pushes = 0; pushes < row.size(); pushes++) {
+            openBucket_t *bucket = &row[pushes];
+            bool taken = (estimate == open->first && pushes + 1 == row.size());
+
+            if(bucket->chunks.size() < (taken ? 2u : 1u))
+                continue;
+
+            std::vector<uint8_t> &chunk = bucket->chunks.front();
+            spillExtent_t extent = allocExtent(open->spill, chunk.size());
+
+            if(writeSpill(open->spill, extent.offset, chunk.data(), chunk.size()))
+                return ERROR;
+
+            bucket->spilled.push_back(extent);
+            release(open->budget, &open->memoryUsed, chunk.capacity());
+            bucket->chunks.erase(bucket->chunks.begin());
+
+            *spilled = true;
+            return SUCCESS;
+        }
+    }
+
+    return SUCCESS;
+}
+
+
+int fitMemory(stateStore_t *closed, openList_t *open) {
+    memoryBudget_t *budget = closed->budget;
+
+    while(budget->cap > 0 && budget->used + tableBytes(closed, closed->capacity) > budget->cap) {
+        bool spilled = false;
+
+        // states of higher estimates are needed last and read back only once
+        if(spillOpenList(open, false, &spilled))
+            return ERROR;
+
+        if(!spilled && closed->count > 0) {
+            if(flushStates(closed))
+                return ERROR;
+            spilled = true;
+        }
+
+        if(!spilled && spillOpenList(open, true, &spilled))
+            return ERROR;
+
+        // what is left are indexes and bloom filters of runs
+        if(!spilled)
+            break;
+    }
+
+    return SUCCESS;
+}
@@ -0,0 +1,339 @@
+//
+// Created by Marcin Jarczewski on 19.10.2026.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/draw.h"
+#include "../include/graphics.h"
+#include "../include/level.h"
+#include "../include/fingerprint.h"
+#include "../include/consts.h"
+
+extern "C" {
+#include"SDL.h"
+#include"SDL_main.h"
+}
+
+const int ATLAS_SIZE = 4096;
+
+typedef struct thumbJob {
+    std::vector<level_t> levels;
+    std::vector<std::string> names;
+    levelIndex_t index;
+    thumbSprites_t sprites;
+    int threads;
+    const char *outDir, *atlasName;
+
+    // atlas pages are split in equal cells, each thread draws only into its cells
+    std::vector<SDL_Surface*> pages;
+    int cellWidth, cellHeight, cellsPerRow, cellsPerPage;
+
+    std::atomic<int> next, failed;
+} thumbJob_t;
+
+
+// sprite converted to ARGB8888 and scaled to tile, done once before threads start
+static SDL_Surface *loadSprite(const char *path, int tile) {
+    SDL_Surface *bmp = SDL_LoadBMP(path);
+    if(bmp == NULL) {
+        printf("SDL_LoadBMP(%s) error: %s\n", path, SDL_GetError());
+        return NULL;
+    }
+
+    SDL_Surface *argb = SDL_ConvertSurfaceFormat(bmp, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_Surface *sprite = SDL_CreateRGBSurfaceWithFormat(0, tile, tile, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_FreeSurface(bmp);
+
+    if(argb == NULL || sprite == NULL) {
+        SDL_FreeSurface(argb);
+        SDL_FreeSurface(sprite);
+        return NULL;
+    }
+
+    SDL_SetSurfaceBlendMode(argb, SDL_BLENDMODE_NONE);
+    SDL_BlitScaled(argb, NULL, sprite, NULL);
+    SDL_FreeSurface(argb);
+
+    return sprite;
+}
+
+
+static int loadSprites(thumbSprites_t *sprites, int tile) {
+    sprites->tile = tile;
+    sprites->field.empty = loadSprite("../assets/empty.bmp", tile);
+    sprites->field.wall = loadSprite("../assets/wall.bmp", tile);
+    sprites->field.chest = loadSprite("../assets/crate_01.bmp", tile);
+    sprites->field.chestDest = loadSprite("../assets/crate_27.bmp", tile);
+    sprites->field.chestAtDest = loadSprite("../assets/crate_12.bmp", tile);
+    sprites->player = loadSprite("../assets/player/pDown1.bmp", tile);
+
+    if(sprites->field.empty == NULL || sprites->field.wall == NULL || sprites->field.chest == NULL ||
+       sprites->field.chestDest == NULL || sprites->field.chestAtDest == NULL || sprites->player == NULL)
+        return ERROR;
+
+    return SUCCESS;
+}
+
+
+static void freeSprites(thumbSprites_t *sprites) {
+    SDL_FreeSurface(sprites->field.empty);
+    SDL_FreeSurface(sprites->field.wall);
+    SDL_FreeSurface(sprites->field.chest);
+    SDL_FreeSurface(sprites->field.chestDest);
+    SDL_FreeSurface(sprites->field.chestAtDest);
+    SDL_FreeSurface(sprites->player);
+}
+
+
+// previews are named by fingerprint, so copies of one level are drawn once
+static void addToJob(thumbJob_t *job, level_t *level, const char *name) {
+    if(job->atlasName == NULL && !addLevel(&job->index, levelFingerprint(level), name)) {
+        freeLevel(level);
+        return;
+    }
+
+    job->levels.push_back(*level);
+    job->names.push_back(name);
+}
+
+
+// levels in loadLevel() format are single .txt files, anything else is read as XSB collection
+static void readLevels(thumbJob_t *job, const char *path) {
+    level_t level;
+    size_t length = strlen(path);
+
+    if(length > 4 && strcmp(path + length - 4, ".txt") == 0) {
+        if(parseLevel(path, &level)) {
+            printf("cannot read %s\n", path);
+            return;
+        }
+
+        addToJob(job, &level, path);
+        return;
+    }
+
+    FILE *in = fopen(path, "r");
+    if(in == NULL) {
+        printf("cannot read %s\n", path);
+        return;
+    }
+
+    char title[MAX_TEXT_LENGTH], name[MAX_TEXT_LENGTH];
+    int rc, number = 0;
+
+    while((rc = readLevelXSB(in, &level, title)) != QUIT) {
+        number++;
+        if(rc == ERROR)
+            continue;
+
+        snprintf(name, MAX_TEXT_LENGTH, "%s:%d", path, number);
+        addToJob(job, &level, name);
+    }
+
+    fclose(in);
+}
+
+
+static void renderToFile(thumbJob_t *job, int index, SDL_Surface **surface) {
+    const level_t *level = &job->levels[index];
+    int tile = job->sprites.tile;
+    int width = level->board.cols * tile, height = level->board.rows * tile;
+
+    // thread reuses its surface while levels have the same size
+    if(*surface == NULL || (*surface)->w != width || (*surface)->h != height) {
+        SDL_FreeSurface(*surface);
+        *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if(*surface == NULL) {
+            job->failed++;
+            return;
+        }
+    }
+
+    drawThumbnail(*surface, &job->sprites, level, 0, 0);
+
+    char path[MAX_TEXT_LENGTH];
+    snprintf(path, MAX_TEXT_LENGTH, "%s/%016llx.bmp", job->outDir, (unsigned long long)levelFingerprint(level));
+    if(SDL_SaveBMP(*surface, path) != 0)
+        job->failed++;
+}
+
+
+static void renderToAtlas(thumbJob_t *job, int index) {
+    SDL_Surface *page = job->pages[index / job->cellsPerPage];
+    int cell = index % job->cellsPerPage;
+
+    drawThumbnail(page, &job->sprites, &job->levels[index],
+                  (cell % job->cellsPerRow) * job->cellWidth, (cell / job->cellsPerRow) * job->cellHeight);
+}
+
+
+static void worker(thumbJob_t *job) {
+    SDL_Surface *surface = NULL;
+
+    for(int index = job->next++; index < (int)job->levels.size(); index = job->next++) {
+        if(job->atlasName != NULL)
+            renderToAtlas(job, index);
+        else
+            renderToFile(job, index, &surface);
+    }
+
+    SDL_FreeSurface(surface);
+}
+
+
+static int createAtlas(thumbJob_t *job) {
+    job->cellWidth = job->cellHeight = job->sprites.tile;
+
+    for(size_t i = 0; i < job->levels.size(); i++) {
+        int width = job->levels[i].board.cols * job->sprites.tile;
+        int height = job->levels[i].board.rows * job->sprites.tile;
+
+        job->cellWidth = (width > job->cellWidth ? width : job->cellWidth);
+        job->cellHeight = (height > job->cellHeight ? height : job->cellHeight);
+    }
+
+    if(job->cellWidth > ATLAS_SIZE || job->cellHeight > ATLAS_SIZE)
+        return ERROR;
+
+    job->cellsPerRow = ATLAS_SIZE / job->cellWidth;
+    job->cellsPerPage = job->cellsPerRow * (ATLAS_SIZE / job->cellHeight);
+
+    int pages = (job->levels.size() + job->cellsPerPage - 1) / job->cellsPerPage;
+    for(int page = 0; page < pages; page++) {
+        int cells = job->levels.size() - page * job->cellsPerPage;
+        cells = (cells < job->cellsPerPage ? cells : job->cellsPerPage);
+
+        int width = (cells < job->cellsPerRow ? cells : job->cellsPerRow) * job->cellWidth;
+        int height = ((cells + job->cellsPerRow - 1) / job->cellsPerRow) * job->cellHeight;
+
+        SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if(surface == NULL)
+            return ERROR;
+
+        SDL_FillRect(surface, NULL, 0);
+        job->pages.push_back(surface);
+    }
+
+    return SUCCESS;
+}
+
+
+// writes atlas pages and text index: level, page, x, y, width, height
+static int saveAtlas(thumbJob_t *job) {
+    char path[MAX_TEXT_LENGTH];
+    int rc = SUCCESS;
+
+    for(size_t page = 0; page < job->pages.size(); page++) {
+        snprintf(path, MAX_TEXT_LENGTH, "%s/%s_%d.bmp", job->outDir, job->atlasName, (int)page);
+        if(SDL_SaveBMP(job->pages[page], path) != 0)
+            rc = ERROR;
+    }
+
+    snprintf(path, MAX_TEXT_LENGTH, "%s/%s.txt", job->outDir, job->atlasName);
+    FILE *out = fopen(path, "w");
+    if(out == NULL)
+        return ERROR;
+
+    for(size_t i = 0; i < job->levels.size(); i++) {
+        int cell = i % job->cellsPerPage;
+        fprintf(out, "%s %d %d %d %d %d\n", job->names[i].c_str(), (int)(i / job->cellsPerPage),
+                (cell % job->cellsPerRow) * job->cellWidth, (cell / job->cellsPerRow) * job->cellHeight,
+                job->levels[i].board.cols * job->sprites.tile, job->levels[i].board.rows * job->sprites.tile);
+    }
+
+    fclose(out);
+    return rc;
+}
+
+
+static int renderThumbnails(thumbJob_t *job) {
+    if(job->atlasName != NULL && createAtlas(job)) {
+        printf("cannot create atlas\n");
+        return ERROR;
+    }
+
+    std::vector<std::thread> threads;
+    for(int i = 0; i < job->threads; i++)
+        threads.push_back(std::thread(worker, job));
+
+    for(size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+
+    if(job->atlasName != NULL && saveAtlas(job))
+        job->failed++;
+
+    printf("rendered %d levels, %d failed\n", (int)job->levels.size(), (int)job->failed);
+    return (job->failed ? ERROR : SUCCESS);
+}
+
+
+#ifdef __cplusplus
+extern "C"
+#endif
+int main(int argc, char **argv) {
+    thumbJob_t job;
+    int tile = 16, first = 1;
+
+    job.threads = std::thread::hardware_concurrency();
+    job.outDir = ".";
+    job.atlasName = NULL;
+    job.next = 0;
+    job.failed = 0;
+    openLevelIndex(&job.index, NULL);
+
+    for(; first + 1 < argc && argv[first][0] == '-'; first += 2) {
+        if(strcmp(argv[first], "-t") == 0)
+            tile = atoi(argv[first + 1]);
+        else if(strcmp(argv[first], "-j") == 0)
+            job.threads = atoi(argv[first + 1]);
+        else if(strcmp(argv[first], "-o") == 0)
+            job.outDir = argv[first + 1];
+        else if(strcmp(argv[first], "-a") == 0)
+            job.atlasName = argv[first + 1];
+        else
+            break;
+    }
+
+    if(first >= argc || tile <= 0) {
+        printf("usage: sokoban_thumbs [-t tilePixels] [-j threads] [-o dir] [-a atlasName] levels...\n");
+        return ERROR;
+    }
+
+    if(job.threads <= 0)
+        job.threads = 1;
+
+    // no window is ever opened, dummy driver works without display
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    if(SDL_Init(SDL_INIT_VIDEO) != 0) {
+        printf("SDL_Init error: %s\n", SDL_GetError());
+        return ERROR;
+    }
+
+    int rc = loadSprites(&job.sprites, tile);
+
+    if(rc == SUCCESS) {
+        for(int i = first; i < argc; i++)
+            readLevels(&job, argv[i]);
+
+        rc = renderThumbnails(&job);
+    }
+
+    for(size_t i = 0; i < job.pages.size(); i++)
+        SDL_FreeSurface(job.pages[i]);
+    for(size_t i = 0; i < job.levels.size(); i++)
+        freeLevel(&job.levels[i]);
+
+    closeLevelIndex(&job.index);
+    freeSprites(&job.sprites);
+    SDL_Quit();
+
+    return rc;
+}